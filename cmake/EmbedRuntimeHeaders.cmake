@@ -0,0 +1,70 @@
+## -*- mode: CMake -*-
+##
+## Copyright (c) 2026 The University of Utah
+## All rights reserved.
+##
+## This file is part of `csmith', a random generator of C programs.
+##
+## Redistribution and use in source and binary forms, with or without
+## modification, are permitted provided that the following conditions are met:
+##
+##   * Redistributions of source code must retain the above copyright notice,
+##     this list of conditions and the following disclaimer.
+##
+##   * Redistributions in binary form must reproduce the above copyright
+##     notice, this list of conditions and the following disclaimer in the
+##     documentation and/or other materials provided with the distribution.
+##
+## THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+## AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+## IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+## ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+## LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+## CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+## SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+## INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+## CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+## ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+## POSSIBILITY OF SUCH DAMAGE.
+
+
+###############################################################################
+
+# Write a C++ source file that defines RuntimePrelude::headers_, the text of
+# the runtime headers that `csmith --self-contained' copies into the programs
+# it generates.
+#
+# usage: cmake -P EmbedRuntimeHeaders.cmake <output.cpp> <header>...
+#
+# The headers are written as raw string literals, cut into pieces that stay
+# below the string literal limits of some compilers.
+
+set(piece_size 4000)
+set(delim "csmith_rt")
+
+math(EXPR last_arg "${CMAKE_ARGC} - 1")
+set(output "${CMAKE_ARGV3}")
+set(text "// Generated by cmake/EmbedRuntimeHeaders.cmake; do not edit.\n\n")
+string(APPEND text "#include \"RuntimePrelude.h\"\n\n")
+string(APPEND text "const RuntimeHeader RuntimePrelude::headers_[] = {\n")
+foreach(i RANGE 4 ${last_arg})
+  set(header "${CMAKE_ARGV${i}}")
+  get_filename_component(name "${header}" NAME)
+  file(READ "${header}" contents)
+  string(LENGTH "${contents}" len)
+  string(APPEND text "    {\"${name}\",\n")
+  set(pos 0)
+  while(pos LESS len)
+    string(SUBSTRING "${contents}" ${pos} ${piece_size} piece)
+    string(APPEND text "     R\"${delim}(${piece})${delim}\"\n")
+    math(EXPR pos "${pos} + ${piece_size}")
+  endwhile()
+  string(APPEND text "    },\n")
+endforeach()
+string(APPEND text "    {nullptr, nullptr}};\n")
+
+file(WRITE "${output}" "${text}")
+
+###############################################################################
+
+## End of file.
@@ -44,9 +44,172 @@
 #define __STDC_LIMIT_MACROS
 #include "random_inc.h"
 
-static uint32_t crc32_tab[256];
+/*
+ * The checksum is selected by the generator (--checksum-kind):
+ *
+ * CSMITH_CHECKSUM_SLICE8: CRC-32 computed a word at a time with the
+ *   slicing-by-8 tables; the checksums are the same as with the default
+ *   byte-at-a-time CRC-32.
+ * CSMITH_CHECKSUM_MIX: a table-free multiply-and-mix hash of each value; the
+ *   checksums differ from CRC-32.
+ */
+
 static uint32_t crc32_context = 0xFFFFFFFFUL;
 
+#if defined(CSMITH_CHECKSUM_MIX)
+
+static void crc32_gentab(void) {}
+
+#if defined(__SPLAT__) || defined(NO_LONGLONG)
+static void crc32_mix(uint32_t val) {
+  uint32_t h = val * 0x9E3779B1UL;
+  h ^= h >> 15;
+  h += crc32_context;
+  h *= 0x85EBCA77UL;
+  crc32_context = h ^ (h >> 13);
+}
+
+static void transparent_crc(uint32_t val, char *vname, int flag) {
+  crc32_mix(val);
+  if (flag) {
+    printf("...checksum after hashing %s : %X\n", vname,
+           crc32_context ^ 0xFFFFFFFFU);
+  }
+}
+#else
+static void crc32_mix(uint64_t val) {
+  uint64_t h = val * 0x9E3779B97F4A7C15ULL;
+  h ^= h >> 29;
+  h += crc32_context;
+  h *= 0xBF58476D1CE4E5B9ULL;
+  crc32_context = (uint32_t)(h >> 32);
+}
+
+static void transparent_crc(uint64_t val, char *vname, int flag) {
+  crc32_mix(val);
+  if (flag) {
+    printf("...checksum after hashing %s : %lX\n", vname,
+           crc32_context ^ 0xFFFFFFFFUL);
+  }
+}
+#endif
+
+static void transparent_crc_bytes(char *ptr, int nbytes, char *vname,
+                                  int flag) {
+  const unsigned char *p = (const unsigned char *)ptr;
+  int i;
+  for (i = 0; i + 4 <= nbytes; i += 4) {
+    crc32_mix((uint32_t)p[i] | (uint32_t)p[i + 1] << 8 |
+              (uint32_t)p[i + 2] << 16 | (uint32_t)p[i + 3] << 24);
+  }
+  for (; i < nbytes; i++) {
+    crc32_mix(p[i]);
+  }
+  if (flag) {
+    printf("...checksum after hashing %s : %lX\n", vname,
+           crc32_context ^ 0xFFFFFFFFUL);
+  }
+}
+
+#elif defined(CSMITH_CHECKSUM_SLICE8)
+
+static uint32_t crc32_slice_tab[8][256];
+
+static void crc32_gentab(void) {
+  uint32_t crc;
+  const uint32_t poly = 0xEDB88320UL;
+  int i, j;
+
+  for (i = 0; i < 256; i++) {
+    crc = i;
+    for (j = 8; j > 0; j--) {
+      if (crc & 1) {
+        crc = (crc >> 1) ^ poly;
+      } else {
+        crc >>= 1;
+      }
+    }
+    crc32_slice_tab[0][i] = crc;
+  }
+  for (i = 0; i < 256; i++) {
+    crc = crc32_slice_tab[0][i];
+    for (j = 1; j < 8; j++) {
+      crc = (crc >> 8) ^ crc32_slice_tab[0][crc & 0xFF];
+      crc32_slice_tab[j][i] = crc;
+    }
+  }
+}
+
+static void crc32_byte(uint8_t b) {
+  crc32_context = ((crc32_context >> 8) & 0x00FFFFFF) ^
+                  crc32_slice_tab[0][(crc32_context ^ b) & 0xFF];
+}
+
+static void crc32_8bytes(uint32_t lo, uint32_t hi) {
+  lo ^= crc32_context;
+  crc32_context = crc32_slice_tab[7][lo & 0xFF] ^
+                  crc32_slice_tab[6][(lo >> 8) & 0xFF] ^
+                  crc32_slice_tab[5][(lo >> 16) & 0xFF] ^
+                  crc32_slice_tab[4][lo >> 24] ^
+                  crc32_slice_tab[3][hi & 0xFF] ^
+                  crc32_slice_tab[2][(hi >> 8) & 0xFF] ^
+                  crc32_slice_tab[1][(hi >> 16) & 0xFF] ^
+                  crc32_slice_tab[0][hi >> 24];
+}
+
+static uint32_t crc32_load4(const unsigned char *p) {
+  return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 |
+         (uint32_t)p[3] << 24;
+}
+
+#if defined(__SPLAT__) || defined(NO_LONGLONG)
+static void crc32_4bytes(uint32_t val) {
+  const uint32_t lo = val ^ crc32_context;
+  crc32_context = crc32_slice_tab[3][lo & 0xFF] ^
+                  crc32_slice_tab[2][(lo >> 8) & 0xFF] ^
+                  crc32_slice_tab[1][(lo >> 16) & 0xFF] ^
+                  crc32_slice_tab[0][lo >> 24];
+}
+
+static void transparent_crc(uint32_t val, char *vname, int flag) {
+  crc32_4bytes(val);
+  if (flag) {
+    printf("...checksum after hashing %s : %X\n", vname,
+           crc32_context ^ 0xFFFFFFFFU);
+  }
+}
+#else
+static void transparent_crc(uint64_t val, char *vname, int flag) {
+  crc32_8bytes((uint32_t)val, (uint32_t)(val >> 32));
+  if (flag) {
+    printf("...checksum after hashing %s : %lX\n", vname,
+           crc32_context ^ 0xFFFFFFFFUL);
+  }
+}
+#endif
+
+/* The bytes are fed in memory order, so this is the CRC-32 of the object
+   representation whatever the byte order of the target. */
+static void transparent_crc_bytes(char *ptr, int nbytes, char *vname,
+                                  int flag) {
+  const unsigned char *p = (const unsigned char *)ptr;
+  int i;
+  for (i = 0; i + 8 <= nbytes; i += 8) {
+    crc32_8bytes(crc32_load4(p + i), crc32_load4(p + i + 4));
+  }
+  for (; i < nbytes; i++) {
+    crc32_byte(p[i]);
+  }
+  if (flag) {
+    printf("...checksum after hashing %s : %lX\n", vname,
+           crc32_context ^ 0xFFFFFFFFUL);
+  }
+}
+
+#else
+
+static uint32_t crc32_tab[256];
+
 static void crc32_gentab(void) {
   uint32_t crc;
   const uint32_t poly = 0xEDB88320UL;
@@ -119,6 +282,8 @@ static void transparent_crc_bytes(char *ptr, int nbytes, char *vname,
   }
 }
 
+#endif
+
 /*****************************************************************************/
 
 #endif
@@ -94,6 +94,8 @@ char __executed_checks[N_WRAP + 1];
 #include "safe_math_macros_notmp.h"
 #elif defined(USE_MATH_MACROS)
 #include "safe_math_macros.h"
+#elif defined(CSMITH_TAILORED_SAFE_MATH)
+/* the program defines the safe math wrappers it uses itself */
 #else
 #define FUNC_NAME(x) (safe_##x)
 #include "safe_math.h"
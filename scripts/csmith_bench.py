@@ -0,0 +1,377 @@
+#!/usr/bin/env python3
+
+import argparse
+import json
+import os
+import random
+import shlex
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+from dataclasses import dataclass, field
+from typing import Dict, List, Optional
+
+
+# Same feature set as driver/random_test and compare_csmith_outputs.py.
+ALL_SWARM_OPTS = [
+    "arrays",
+    "bitfields",
+    "checksum",
+    "comma-operators",
+    "compound-assignment",
+    "consts",
+    "divs",
+    "embedded-assigns",
+    "jumps",
+    "longlong",
+    "force-non-uniform-arrays",
+    "math64",
+    "muls",
+    "packed-struct",
+    "paranoid",
+    "pointers",
+    "structs",
+    "volatiles",
+    "volatile-pointers",
+    "inline-function",
+    "return-structs",
+    "arg-structs",
+    "dangling-global-pointers",
+    "return-dead-pointer",
+]
+
+PHASES = [
+    "program",
+    "types",
+    "functions",
+    "function_body",
+    "fixed_point",
+    "output",
+]
+
+COUNTERS = [
+    "fixed_point_iterations",
+    "shortcut_hits",
+    "shortcut_conflicts",
+    "shortcut_misses",
+    "filter_retries",
+    "call_summary_hits",
+    "call_summary_misses",
+    "dfs_duplicates",
+]
+
+
+@dataclass
+class Run:
+    """One csmith invocation of a profile."""
+
+    args: List[str]
+    # Programs expected from this invocation; 0 when unknown (DFS mode).
+    programs: int
+    batch: bool = False
+    split: bool = False
+
+
+@dataclass
+class ProfileResult:
+    name: str
+    programs: int = 0
+    bytes: int = 0
+    failures: int = 0
+    wall_s: float = 0.0
+    peak_rss_kb: int = 0
+    phase_ms: Dict[str, float] = field(default_factory=dict)
+    phase_calls: Dict[str, int] = field(default_factory=dict)
+    counters: Dict[str, int] = field(default_factory=dict)
+
+
+def resolve_executable(path: str) -> str:
+    if os.path.sep in path:
+        resolved = path
+    else:
+        resolved = shutil.which(path) or ""
+    if not resolved:
+        raise FileNotFoundError(f"executable not found: {path}")
+    if not os.path.isfile(resolved):
+        raise FileNotFoundError(f"not a file: {resolved}")
+    if not os.access(resolved, os.X_OK):
+        raise PermissionError(f"not executable: {resolved}")
+    return os.path.abspath(resolved)
+
+
+def make_swarm_args(rng: random.Random) -> List[str]:
+    p = rng.random()
+    args: List[str] = []
+    for opt in ALL_SWARM_OPTS:
+        if rng.random() < p:
+            args.append(f"--{opt}")
+        else:
+            args.append(f"--no-{opt}")
+    return args
+
+
+def seed_range(first: int, count: int) -> List[str]:
+    return ["--seed-range", f"{first}..{first + count - 1}"]
+
+
+def make_profiles(first: int, count: int) -> Dict[str, List[Run]]:
+    """The fixed benchmark corpus. Every profile is a pure function of
+    (first, count), so two csmith builds see exactly the same workload."""
+    seeds = range(first, first + count)
+    # Like driver/random_test: one swarm configuration per program, drawn
+    # from a generator keyed by the seed so the corpus never changes.
+    swarm = [
+        Run(
+            ["--seed", str(s), "--no-unions", "--no-float", "--no-argc"]
+            + make_swarm_args(random.Random(s)),
+            1,
+        )
+        for s in seeds
+    ]
+    # DFS mode ignores the seed; keep it bounded so it finishes quickly.
+    dfs = [
+        Run(["--dfs-exhaustive", "--max-exhaustive-depth", "2",
+             "--max-funcs", "1"], 0)
+    ]
+    split = [
+        Run(["--seed", str(s), "--max-split-files", "4"], 1, split=True)
+        for s in seeds
+    ]
+    return {
+        "default": [Run(seed_range(first, count), count, batch=True)],
+        "swarm": swarm,
+        "max-funcs": [
+            Run(seed_range(first, count) + ["--max-funcs", "30"], count,
+                batch=True)
+        ],
+        "dfs-exhaustive": dfs,
+        "split-files": split,
+    }
+
+
+def dir_bytes(path: str) -> int:
+    total = 0
+    for root, _, files in os.walk(path):
+        for name in files:
+            total += os.path.getsize(os.path.join(root, name))
+    return total
+
+
+def run_one(
+    exe: str, run: Run, workdir: str, timeout_s: float, verbose: bool
+) -> dict:
+    """Run csmith once in a scratch directory and measure it. Peak RSS is
+    taken from wait4() so it belongs to this child only."""
+    if os.path.isdir(workdir):
+        shutil.rmtree(workdir)
+    os.makedirs(workdir)
+    stats = os.path.join(workdir, "stats.json")
+    out_path = os.path.join(workdir, "stdout.c")
+    cmd = [exe, *run.args, "--stats-json", stats]
+    if run.batch:
+        cmd += ["--batch-dir", os.path.join(workdir, "batch")]
+    if run.split:
+        cmd += ["--split-files-dir", os.path.join(workdir, "split")]
+    if verbose:
+        print(shlex.join(cmd), file=sys.stderr, flush=True)
+
+    with open(out_path, "wb") as out:
+        start = time.perf_counter()
+        proc = subprocess.Popen(
+            cmd, cwd=workdir, stdout=out, stderr=subprocess.DEVNULL
+        )
+        deadline = start + timeout_s
+        timed_out = False
+        while True:
+            pid, status, rusage = os.wait4(proc.pid, os.WNOHANG)
+            if pid != 0:
+                break
+            if time.perf_counter() > deadline:
+                proc.kill()
+                _, status, rusage = os.wait4(proc.pid, 0)
+                timed_out = True
+                break
+            time.sleep(0.001)
+        wall = time.perf_counter() - start
+    # The child was reaped above; tell Popen so it does not wait again.
+    proc.returncode = os.waitstatus_to_exitcode(status)
+
+    entries = []
+    if os.path.exists(stats):
+        with open(stats) as f:
+            entries = [json.loads(line) for line in f if line.strip()]
+        os.remove(stats)
+    return {
+        "ok": not timed_out and proc.returncode == 0,
+        "wall_s": wall,
+        "rss_kb": rusage.ru_maxrss,
+        "bytes": dir_bytes(workdir),
+        "stats": entries,
+    }
+
+
+def run_profile(
+    exe: str,
+    name: str,
+    runs: List[Run],
+    scratch: str,
+    repeat: int,
+    timeout_s: float,
+    verbose: bool,
+) -> ProfileResult:
+    res = ProfileResult(name)
+    for phase in PHASES:
+        res.phase_ms[phase] = 0.0
+        res.phase_calls[phase] = 0
+    for counter in COUNTERS:
+        res.counters[counter] = 0
+
+    for i, run in enumerate(runs):
+        # Keep the fastest of `repeat` runs to damp scheduler noise; the
+        # generated programs are identical across repetitions.
+        best: Optional[dict] = None
+        for _ in range(repeat):
+            r = run_one(exe, run, os.path.join(scratch, f"{name}-{i}"),
+                        timeout_s, verbose)
+            if best is None or r["wall_s"] < best["wall_s"]:
+                best = r
+            res.peak_rss_kb = max(res.peak_rss_kb, r["rss_kb"])
+        assert best is not None
+        if not best["ok"]:
+            res.failures += 1
+            continue
+        res.wall_s += best["wall_s"]
+        res.bytes += best["bytes"]
+        res.programs += run.programs if run.programs else 1
+        for entry in best["stats"]:
+            for phase in PHASES:
+                p = entry["phases"].get(phase, {})
+                res.phase_ms[phase] += p.get("ms", 0.0)
+                res.phase_calls[phase] += p.get("calls", 0)
+            for counter in COUNTERS:
+                res.counters[counter] += entry["counters"].get(counter, 0)
+    return res
+
+
+def rate(n: float, secs: float) -> float:
+    return n / secs if secs > 0 else 0.0
+
+
+def print_report(results: List[ProfileResult], timing: bool) -> None:
+    # The corpus section depends only on what csmith generated: it is
+    # identical between two builds unless generation itself changed.
+    print("# corpus")
+    print(f"{'profile':<16}{'programs':>10}{'bytes':>12}{'failures':>10}")
+    for r in results:
+        print(f"{r.name:<16}{r.programs:>10}{r.bytes:>12}{r.failures:>10}")
+    print()
+    print("# counters")
+    print(f"{'profile':<16}" + "".join(f"{c:>24}" for c in COUNTERS))
+    for r in results:
+        print(f"{r.name:<16}"
+              + "".join(f"{r.counters[c]:>24}" for c in COUNTERS))
+    if not timing:
+        return
+    print()
+    print("# throughput")
+    print(f"{'profile':<16}{'wall_s':>10}{'programs/s':>12}{'KB/s':>12}"
+          f"{'peak_rss_kb':>14}")
+    for r in results:
+        print(f"{r.name:<16}{r.wall_s:>10.3f}"
+              f"{rate(r.programs, r.wall_s):>12.2f}"
+              f"{rate(r.bytes / 1024.0, r.wall_s):>12.1f}"
+              f"{r.peak_rss_kb:>14}")
+    print()
+    print("# phase ms")
+    print(f"{'profile':<16}" + "".join(f"{p:>15}" for p in PHASES))
+    for r in results:
+        print(f"{r.name:<16}"
+              + "".join(f"{r.phase_ms[p]:>15.1f}" for p in PHASES))
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(
+        description=(
+            "Measure csmith generation throughput on a fixed seed corpus under "
+            "several option profiles. The corpus and counter sections are "
+            "deterministic and can be diffed between builds; the throughput "
+            "and phase sections are wall-clock measurements."
+        )
+    )
+    parser.add_argument("exe", help="Path to the csmith executable.")
+    parser.add_argument(
+        "-n",
+        "--seeds",
+        type=int,
+        default=10,
+        help="Number of seeds per profile (default: 10).",
+    )
+    parser.add_argument(
+        "--first-seed",
+        type=int,
+        default=1,
+        help="First seed of the corpus (default: 1).",
+    )
+    parser.add_argument(
+        "--profile",
+        action="append",
+        default=[],
+        help="Only run the named profile; may be repeated.",
+    )
+    parser.add_argument(
+        "--repeat",
+        type=int,
+        default=1,
+        help="Time every run this many times and keep the fastest "
+        "(default: 1).",
+    )
+    parser.add_argument(
+        "--timeout",
+        type=float,
+        default=60.0,
+        help="Per-run timeout in seconds (default: 60).",
+    )
+    parser.add_argument(
+        "--no-timing",
+        action="store_true",
+        help="Only print the deterministic sections.",
+    )
+    parser.add_argument(
+        "--json", metavar="FILE", help="Also write the raw results to FILE."
+    )
+    parser.add_argument(
+        "-v", "--verbose", action="store_true", help="Print every command."
+    )
+    args = parser.parse_args()
+
+    if args.seeds < 1 or args.repeat < 1:
+        parser.error("--seeds and --repeat must be positive")
+    exe = resolve_executable(args.exe)
+    profiles = make_profiles(args.first_seed, args.seeds)
+    names = args.profile or list(profiles)
+    for name in names:
+        if name not in profiles:
+            parser.error(f"unknown profile: {name} "
+                         f"(known: {', '.join(profiles)})")
+
+    results = []
+    with tempfile.TemporaryDirectory(prefix="csmith_bench.") as scratch:
+        for name in names:
+            results.append(
+                run_profile(exe, name, profiles[name], scratch, args.repeat,
+                            args.timeout, args.verbose)
+            )
+
+    print_report(results, not args.no_timing)
+    if args.json:
+        with open(args.json, "w") as f:
+            json.dump([r.__dict__ for r in results], f, indent=2,
+                      sort_keys=True)
+            f.write("\n")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -40,7 +40,8 @@
 
 using namespace std;
 
-AbsProgramGenerator *AbsProgramGenerator::current_generator_ = nullptr;
+thread_local AbsProgramGenerator *AbsProgramGenerator::current_generator_ =
+    nullptr;
 
 OutputMgr *AbsProgramGenerator::GetOutputMgr() {
   assert(current_generator_);
@@ -48,13 +49,14 @@ OutputMgr *AbsProgramGenerator::GetOutputMgr() {
 }
 
 AbsProgramGenerator *AbsProgramGenerator::CreateInstance(int argc, char *argv[],
-                                                         unsigned long seed) {
+                                                         unsigned long seed,
+                                                         std::ostream *out) {
   if (CGOptions::dfs_exhaustive()) {
     AbsProgramGenerator::current_generator_ =
         new DFSProgramGenerator(argc, argv, seed);
   } else {
     AbsProgramGenerator::current_generator_ =
-        new DefaultProgramGenerator(argc, argv, seed);
+        new DefaultProgramGenerator(argc, argv, seed, out);
   }
 
   AbsProgramGenerator::current_generator_->initialize();
@@ -30,6 +30,7 @@
 #ifndef ABS_PROGRAM_GENERATOR_H
 #define ABS_PROGRAM_GENERATOR_H
 
+#include <ostream>
 #include <string>
 
 class OutputMgr;
@@ -37,7 +38,8 @@ class OutputMgr;
 class AbsProgramGenerator {
 public:
   static AbsProgramGenerator *CreateInstance(int argc, char *argv[],
-                                             unsigned long seed);
+                                             unsigned long seed,
+                                             std::ostream *out = nullptr);
 
   static AbsProgramGenerator *GetInstance();
 
@@ -57,7 +59,7 @@ protected:
   virtual void initialize() = 0;
 
 private:
-  static AbsProgramGenerator *current_generator_;
+  static thread_local AbsProgramGenerator *current_generator_;
 
   static OutputMgr *getmgr(AbsProgramGenerator *gen);
 };
@@ -32,6 +32,7 @@
 #include "AbsRndNumGenerator.h"
 
 #include <cassert>
+#include <cstdint>
 #include <cstdlib>
 #include <iostream>
 
@@ -40,12 +41,9 @@
 
 using namespace std;
 
-#ifndef HAVE_LRAND48
-extern "C" {
-extern void srand48(long seed);
-extern long lrand48(void);
-}
-#endif
+// State of the 48-bit linear congruential generator used by lrand48(3).
+// Each thread has its own, so that programs can be generated concurrently.
+static thread_local uint64_t rand48_state = 0;
 
 const char *AbsRndNumGenerator::hex1 = "0123456789ABCDEF";
 
@@ -83,17 +81,28 @@ AbsRndNumGenerator::make_rndnum_generator(RNDNUM_GENERATOR impl,
   return rImpl;
 }
 
+/*
+ * Same as srand48(seed). The sequences are identical on all platforms,
+ * including the ones whose srand48 is not deterministic by default.
+ */
 void AbsRndNumGenerator::seedrand(const unsigned long seed) {
-#ifdef HAVE_SRAND48_DETERMINISTIC
-  // OpenBSD requires a special call to activate the standard,
-  // deterministic behavior of `lrand48'.
-  srand48_deterministic(seed);
-#else
-  srand48(seed);
-#endif
+  rand48_state = ((static_cast<uint64_t>(seed) & 0xffffffff) << 16) | 0x330e;
 }
 
-unsigned long AbsRndNumGenerator::genrand(void) { return lrand48(); }
+uint64_t AbsRndNumGenerator::get_rand_state(void) { return rand48_state; }
+
+void AbsRndNumGenerator::set_rand_state(uint64_t state) {
+  rand48_state = state;
+}
+
+/*
+ * Same as lrand48(): X(n+1) = (a * X(n) + c) mod 2^48, returning the high
+ * 31 bits
+ */
+unsigned long AbsRndNumGenerator::genrand(void) {
+  rand48_state = (0x5deece66dULL * rand48_state + 0xb) & 0xffffffffffffULL;
+  return static_cast<unsigned long>(rand48_state >> 17);
+}
 
 std::string AbsRndNumGenerator::RandomHexDigits(int num) {
   std::string str;
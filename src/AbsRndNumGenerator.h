@@ -30,6 +30,7 @@
 #ifndef ABS_RNDNUM_GENERATOR
 #define ABS_RNDNUM_GENERATOR
 
+#include <cstdint>
 #include <string>
 
 class Filter;
@@ -51,6 +52,11 @@ public:
 
   static void seedrand(const unsigned long seed);
 
+  // The state of the generator behind genrand, to save and restore it.
+  static uint64_t get_rand_state(void);
+
+  static void set_rand_state(uint64_t state);
+
   static const char *get_hex1();
 
   static const char *get_dec1();
@@ -223,6 +223,11 @@ ArrayVariable::~ArrayVariable(void) {
   }
 }
 
+// magic number used to pick initial values for array elements
+static thread_local unsigned init_seed = 0xABCDEF;
+
+void ArrayVariable::doFinalization(void) { init_seed = 0xABCDEF; }
+
 void ArrayVariable::add_index(const Expression *e) { indices.push_back(e); }
 
 void ArrayVariable::set_index(size_t index, const Expression *e) {
@@ -426,15 +431,15 @@ string
 ArrayVariable::build_init_recursive(size_t dimen,
                                     const vector<string> &init_strings) const {
   assert(dimen < get_dimension());
-  static unsigned seed = 0xABCDEF;
   string ret = "{";
   for (size_t i = 0; i < sizes[dimen]; i++) {
     if (dimen == sizes.size() - 1) {
       // use magic number to choose an initial value
       size_t rnd_index =
-          ((seed * seed + (i + 7) * (i + 13)) * 52369) % (init_strings.size());
+          ((init_seed * init_seed + (i + 7) * (i + 13)) * 52369) %
+          (init_strings.size());
       ret += init_strings[rnd_index];
-      seed++;
+      init_seed++;
     } else {
       ret += build_init_recursive(dimen + 1, init_strings);
     }
@@ -715,12 +720,39 @@ ArrayVariable::make_print_index_str(const vector<const Variable *> &cvs) const {
   return str;
 }
 
+/*
+ * whether every byte of a value of type t is covered by hashing its integer
+ * and float subfields, so the value can be hashed as raw memory: no padding,
+ * bitfields, unions, pointers or volatile fields
+ */
+static bool is_bulk_hashable_type(const Type *t) {
+  if (t->eType == eTypeDesc::eSimple)
+    return t->simple_type != eSimpleType::eVoid;
+  if (t->eType != eTypeDesc::eStruct || t->has_padding() ||
+      t->is_volatile_struct_union())
+    return false;
+  for (size_t i = 0; i < t->fields.size(); i++) {
+    if (!is_bulk_hashable_type(t->fields[i]))
+      return false;
+  }
+  return true;
+}
+
 /* -------------------------------------------------------------
  *  hash all array items
  ***************************************************************/
 void ArrayVariable::hash(std::ostream &out) const {
   if (collective != 0)
     return;
+  // hash the whole array with one call over its memory
+  if (CGOptions::bulk_array_hash() && CGOptions::compute_hash() &&
+      !is_volatile() && is_bulk_hashable_type(type)) {
+    const string name = get_actual_name();
+    output_tab(out, 1);
+    out << "transparent_crc_bytes((char *)" << name << ", sizeof(" << name
+        << "), \"" << name << "\", print_hash_value);" << endl;
+    return;
+  }
   vector<string> field_names;
   vector<const Type *> field_types;
   vector<int> included_fields;
@@ -49,6 +49,7 @@ public:
                                             const Variable *isFieldVarOf);
   ArrayVariable(const ArrayVariable &av);
   virtual ~ArrayVariable(void) override;
+  static void doFinalization(void);
 
   void add_index(const Expression *e);
   void set_index(size_t index, const Expression *e);
@@ -25,6 +25,12 @@ void AttributeGenerator::Output(std::ostream &out) {
     out << "))";
 }
 
+void AttributeGenerator::clear() {
+  for (auto itr = attributes.begin(); itr != attributes.end(); itr++)
+    delete (*itr);
+  attributes.clear();
+}
+
 Attribute::Attribute(const string &name, int prob) : name(name), prob(prob) {}
 
 BooleanAttribute::BooleanAttribute(const string &name, int prob)
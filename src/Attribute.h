@@ -16,6 +16,7 @@ public:
   // Attribute generation probability
   int prob;
   Attribute(const string &, int);
+  virtual ~Attribute() {}
   // Checks attribute probability and generate is accordingly
   virtual string make_random() = 0;
 };
@@ -61,6 +62,8 @@ public:
   // stores instances of Attribute
   vector<Attribute *> attributes;
   void Output(std::ostream &);
+  // releases all attributes so that they can be re-initialized
+  void clear();
 };
 
 #endif
@@ -55,6 +55,8 @@
 #include "FactMgr.h"
 #include "Function.h"
 #include "FunctionInvocationUser.h"
+#include "GenBudget.h"
+#include "Profiler.h"
 #include "Statement.h"
 #include "StatementGoto.h"
 #include "Variable.h"
@@ -85,6 +87,9 @@ Block *find_block_by_id(int blk_id) {
  *
  */
 static unsigned int BlockProbability(Block &block) {
+  // fill function bodies up while the program is below --min-size
+  if (!block.parent && GenBudget::below_min_size())
+    return block.block_size() - 1;
   vector<unsigned int> v;
   v.push_back(block.block_size() - 1);
   VectorFilter filter(v, VectorFilter::Mode::Keep);
@@ -144,6 +149,9 @@ Block *Block::make_random(CGContext &cg_context, bool looping) {
     return nullptr;
   }
   for (unsigned int i = 0; i <= max; ++i) {
+    // stop growing the program once it reaches --max-size
+    if (GenBudget::above_max_size())
+      break;
     Statement *s = Statement::make_random(cg_context);
     // In the exhaustive mode, Statement::make_random could return nullptr;
     if (!s)
@@ -509,38 +517,58 @@ bool Block::contains_back_edge(void) const {
  *    fail_index: records which statement in this block caused analyzer to fail
  *    visit_one: when is true, the statements in this block must be visited at
  * least once
+ *
+ * the back edges leading to this block are the worklist: each round merges
+ * only those whose source has a new output since the last round. Inside a
+ * round, statements whose inputs did not change take the shortcut (see
+ * Statement::shortcut_analysis). The inputs only grow by merging, so the
+ * rounds reach a fixed point without an iteration cap
  ****************************************************************************************************/
 bool Block::find_fixed_point(const vector<const Fact *> &inputs,
                              vector<const Fact *> &post_facts,
                              CGContext &cg_context, int &fail_index,
                              bool visit_once) const {
+  ProfileScope scope(eProfPhase::eFixedPoint);
   FactMgr *const fm = get_fact_mgr(&cg_context);
   FactVec current_inputs(inputs);
-  // include outputs from all back edges leading to this block
+  // include outputs from all back edges leading to this block, and remember
+  // what was merged from each
   vector<const CFGEdge *> edges;
-  int cnt = 0;
+  vector<FactVec> merged;
+  bool edges_found = false;
+  // whether a round of this call analyzed the statements with current_inputs
+  bool analyzed = false;
   do {
+    Profiler::incr(eProfCounter::eFixedPointIterations);
+    GenBudget::check_time();
     // if we have never visited the block, force the visitor to go through all
     // statements at least once
+    bool changed = false;
     if (fm->map_visited[this]) {
-      if (cnt++ > 7) {
-        // takes too many iterations to reach a fixed point, must be something
-        // wrong
-        assert(0);
+      if (!edges_found) {
+        find_edges_in(edges, false, true);
+        merged.resize(edges.size());
+        edges_found = true;
       }
-      find_edges_in(edges, false, true);
       for (size_t i = 0; i < edges.size(); i++) {
-        const Statement *src = edges[i]->src;
-        // assert(fm->map_visited[src]);
-        merge_facts(current_inputs, fm->map_facts_out[src]);
+        const FactVec &outputs = fm->map_facts_out[edges[i]->src];
+        if (!same_facts(outputs, merged[i])) {
+          merge_facts(current_inputs, outputs);
+          merged[i] = outputs;
+          changed = true;
+        }
       }
     }
     if (!visit_once) {
       const int shortcut = shortcut_analysis(current_inputs, cg_context);
       if (shortcut == 0)
         return true;
+      // also a fixed point when the effect of the block as a whole conflicts
+      // with the context: the last round analyzed the statements with these
+      // inputs, and another one would only repeat it
+      if (shortcut == 1 && analyzed && !changed)
+        return true;
     }
-    // if (shortcut == 1) return false;
 
     FactVec outputs = current_inputs;
     // add facts for locals
@@ -564,6 +592,7 @@ bool Block::find_fixed_point(const vector<const Fact *> &inputs,
     // compute accumulated effect
     set_accumulated_effect(cg_context);
     visit_once = false;
+    analyzed = true;
   } while (true);
   return true;
 }
@@ -98,59 +98,59 @@ public:
   static int stat_blk_depths_for_stmt(const Statement *s);
   static int stat_blk_depths(void);
 
-  static std::vector<int> struct_depth_cnts;
+  static thread_local std::vector<int> struct_depth_cnts;
 
-  static int union_var_cnt;
+  static thread_local int union_var_cnt;
 
-  static std::vector<int> expr_depth_cnts;
+  static thread_local std::vector<int> expr_depth_cnts;
 
-  static std::vector<int> blk_depth_cnts;
+  static thread_local std::vector<int> blk_depth_cnts;
 
-  static std::vector<int> dereference_level_cnts;
+  static thread_local std::vector<int> dereference_level_cnts;
 
-  static int address_taken_cnt;
+  static thread_local int address_taken_cnt;
 
-  static std::vector<int> write_dereference_cnts;
+  static thread_local std::vector<int> write_dereference_cnts;
 
-  static std::vector<int> read_dereference_cnts;
+  static thread_local std::vector<int> read_dereference_cnts;
 
-  static int cmp_ptr_to_null;
-  static int cmp_ptr_to_ptr;
-  static int cmp_ptr_to_addr;
+  static thread_local int cmp_ptr_to_null;
+  static thread_local int cmp_ptr_to_ptr;
+  static thread_local int cmp_ptr_to_addr;
 
-  static int read_volatile_cnt;
-  static int read_volatile_thru_ptr_cnt;
-  static int write_volatile_cnt;
-  static int write_volatile_thru_ptr_cnt;
-  static int read_non_volatile_cnt;
-  static int write_non_volatile_cnt;
+  static thread_local int read_volatile_cnt;
+  static thread_local int read_volatile_thru_ptr_cnt;
+  static thread_local int write_volatile_cnt;
+  static thread_local int write_volatile_thru_ptr_cnt;
+  static thread_local int read_non_volatile_cnt;
+  static thread_local int write_non_volatile_cnt;
 
-  static int pointer_avail_for_dereference;
-  static int volatile_avail;
+  static thread_local int pointer_avail_for_dereference;
+  static thread_local int volatile_avail;
 
-  static int structs_with_bitfields;
-  static std::vector<int> vars_with_bitfields;
-  static std::vector<int> vars_with_full_bitfields;
-  static int vars_with_bitfields_address_taken_cnt;
-  static int bitfields_in_total;
-  static int unamed_bitfields_in_total;
-  static int const_bitfields_in_total;
-  static int volatile_bitfields_in_total;
-  static int lhs_bitfields_structs_vars_cnt;
-  static int rhs_bitfields_structs_vars_cnt;
-  static int lhs_bitfield_cnt;
-  static int rhs_bitfield_cnt;
+  static thread_local int structs_with_bitfields;
+  static thread_local std::vector<int> vars_with_bitfields;
+  static thread_local std::vector<int> vars_with_full_bitfields;
+  static thread_local int vars_with_bitfields_address_taken_cnt;
+  static thread_local int bitfields_in_total;
+  static thread_local int unamed_bitfields_in_total;
+  static thread_local int const_bitfields_in_total;
+  static thread_local int volatile_bitfields_in_total;
+  static thread_local int lhs_bitfields_structs_vars_cnt;
+  static thread_local int rhs_bitfields_structs_vars_cnt;
+  static thread_local int lhs_bitfield_cnt;
+  static thread_local int rhs_bitfield_cnt;
 
-  static int forward_jump_cnt;
-  static int backward_jump_cnt;
+  static thread_local int forward_jump_cnt;
+  static thread_local int backward_jump_cnt;
 
-  static int use_new_var_cnt;
-  static int use_old_var_cnt;
+  static thread_local int use_new_var_cnt;
+  static thread_local int use_old_var_cnt;
 
-  static int oob_cnt;
+  static thread_local int oob_cnt;
 
-  static bool rely_on_int_size;
-  static bool rely_on_ptr_size;
+  static thread_local bool rely_on_int_size;
+  static thread_local bool rely_on_ptr_size;
 };
 
 void incr_counter(std::vector<int> &counters, int index);
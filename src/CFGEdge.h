@@ -30,6 +30,7 @@
 #ifndef CFG_EDGE_H
 #define CFG_EDGE_H
 
+#include "NodePool.h"
 #include "StdLibAliases.h"
 #include <iostream>
 #include <vector>
@@ -47,6 +48,11 @@ public:
   CFGEdge(const CFGEdge &edge);
   virtual ~CFGEdge(void);
 
+  static void *operator new(size_t size) { return NodePool::allocate(size); }
+  static void operator delete(void *p, size_t size) {
+    NodePool::deallocate(p, size);
+  }
+
   // void Output(std::ostream &out) const;
 
   const Statement *src;
@@ -80,10 +80,22 @@ int CGOptions::pointer_size_ = 0;
 ///////////////////////////////////////////////////////////////////////////////
 
 DEFINE_GETTER_SETTER_BOOL(compute_hash)
+DEFINE_GETTER_SETTER_STRING_REF(checksum_kind)
+DEFINE_GETTER_SETTER_BOOL(bulk_array_hash)
+DEFINE_GETTER_SETTER_BOOL(self_contained)
+DEFINE_GETTER_SETTER_BOOL(tailored_safe_math)
 DEFINE_GETTER_SETTER_BOOL(depth_protect)
 DEFINE_GETTER_SETTER_INT(max_split_files)
 DEFINE_GETTER_SETTER_STRING_REF(split_files_dir)
 DEFINE_GETTER_SETTER_STRING_REF(output_file)
+DEFINE_GETTER_SETTER_INT(output_fd)
+DEFINE_GETTER_SETTER_INT(batch_count)
+DEFINE_GETTER_SETTER_STRING_REF(batch_dir)
+DEFINE_GETTER_SETTER_INT(jobs)
+DEFINE_GETTER_SETTER_STRING_REF(stats_json)
+DEFINE_GETTER_SETTER_INT(min_size)
+DEFINE_GETTER_SETTER_INT(max_size)
+DEFINE_GETTER_SETTER_INT(max_gen_ms)
 DEFINE_GETTER_SETTER_INT(max_funcs)
 DEFINE_GETTER_SETTER_INT(max_params)
 DEFINE_GETTER_SETTER_INT(max_block_size)
@@ -113,6 +125,17 @@ DEFINE_GETTER_SETTER_BOOL(random_based)
 DEFINE_GETTER_SETTER_BOOL(dfs_exhaustive)
 DEFINE_GETTER_SETTER_STRING_REF(dfs_debug_sequence)
 DEFINE_GETTER_SETTER_INT(max_exhaustive_depth)
+DEFINE_GETTER_SETTER_INT(dfs_shard_index)
+DEFINE_GETTER_SETTER_INT(dfs_shard_count)
+DEFINE_GETTER_SETTER_STRING_REF(dfs_shard_dir)
+DEFINE_GETTER_SETTER_STRING_REF(dfs_checkpoint)
+DEFINE_GETTER_SETTER_INT(dfs_checkpoint_interval)
+DEFINE_GETTER_SETTER_STRING_REF(dfs_resume)
+DEFINE_GETTER_SETTER_BOOL(dfs_unique)
+DEFINE_GETTER_SETTER_STRING_REF(dfs_unique_file)
+DEFINE_GETTER_SETTER_STRING_REF(dfs_trace)
+DEFINE_GETTER_SETTER_STRING_REF(dfs_replay)
+DEFINE_GETTER_SETTER_INT(dfs_replay_index)
 DEFINE_GETTER_SETTER_BOOL(compact_output)
 DEFINE_GETTER_SETTER_INT(func1_max_params)
 DEFINE_GETTER_SETTER_BOOL(klee)
@@ -215,6 +238,10 @@ void CGOptions::set_default_builtin_kinds() {
 void CGOptions::set_default_settings(void) {
   set_platform_specific_options();
   compute_hash(true);
+  checksum_kind(CGOPTIONS_DEFAULT_CHECKSUM_KIND);
+  bulk_array_hash(false);
+  self_contained(false);
+  tailored_safe_math(false);
   max_funcs(CGOPTIONS_DEFAULT_MAX_SPLIT_FILES);
   max_funcs(CGOPTIONS_DEFAULT_MAX_FUNCS);
   max_params(CGOPTIONS_DEFAULT_MAX_PARAMS);
@@ -231,8 +258,27 @@ void CGOptions::set_default_settings(void) {
       CGOPTIONS_DEFAULT_MAX_ARRAY_LENGTH_PER_DIMENSION);
   max_array_length(CGOPTIONS_DEFAULT_MAX_ARRAY_LENGTH);
   max_exhaustive_depth(CGOPTIONS_DEFAULT_MAX_EXHAUSTIVE_DEPTH);
+  dfs_shard_index(0);
+  dfs_shard_count(1);
+  dfs_shard_dir("");
+  dfs_checkpoint("");
+  dfs_checkpoint_interval(CGOPTIONS_DEFAULT_DFS_CHECKPOINT_INTERVAL);
+  dfs_resume("");
+  dfs_unique(false);
+  dfs_unique_file("");
+  dfs_trace("");
+  dfs_replay("");
+  dfs_replay_index(0);
   max_indirect_level(CGOPTIONS_DEFAULT_MAX_INDIRECT_LEVEL);
   output_file(CGOPTIONS_DEFAULT_OUTPUT_FILE);
+  output_fd(CGOPTIONS_DEFAULT_OUTPUT_FD);
+  batch_count(0);
+  batch_dir("");
+  jobs(1);
+  stats_json("");
+  min_size(0);
+  max_size(0);
+  max_gen_ms(0);
   interested_facts(static_cast<int>(eFactCategory::ePointTo) |
                    static_cast<int>(eFactCategory::eUnionWrite));
   allow_const_volatile(true);
@@ -451,6 +497,71 @@ bool CGOptions::has_delta_conflict() {
   return false;
 }
 
+bool CGOptions::has_batch_conflict() {
+  if (CGOptions::jobs() < 1) {
+    conflict_msg_ = "jobs must be at least 1";
+    return true;
+  }
+  if (CGOptions::batch_count() <= 0) {
+    if (!CGOptions::batch_dir().empty()) {
+      conflict_msg_ =
+          "--batch-dir can only be used with --batch or --seed-range";
+      return true;
+    }
+    if (CGOptions::jobs() > 1) {
+      conflict_msg_ = "--jobs can only be used with --batch or --seed-range";
+      return true;
+    }
+    return false;
+  }
+  if (CGOptions::dfs_exhaustive()) {
+    conflict_msg_ = "--batch cannot be used with --dfs-exhaustive";
+    return true;
+  }
+  if (CGOptions::max_split_files() > 0) {
+    conflict_msg_ = "--batch cannot be used with --max-split-files";
+    return true;
+  }
+  if (!CGOptions::delta_monitor().empty() || !CGOptions::go_delta().empty()) {
+    conflict_msg_ = "--batch cannot be used with delta reduction";
+    return true;
+  }
+  if (!CGOptions::batch_dir().empty() && !CGOptions::output_file().empty()) {
+    conflict_msg_ =
+        "you cannot specify --batch-dir and --output at the same time";
+    return true;
+  }
+  if (!CGOptions::batch_dir().empty()) {
+    if (!DefaultOutputMgr::create_output_dir(CGOptions::batch_dir())) {
+      conflict_msg_ = "cannot create dir for batch output!";
+      return true;
+    }
+  }
+  return false;
+}
+
+bool CGOptions::has_budget_conflict() {
+  if (CGOptions::min_size() <= 0 && CGOptions::max_size() <= 0 &&
+      CGOptions::max_gen_ms() <= 0)
+    return false;
+  if (CGOptions::max_size() > 0 &&
+      CGOptions::min_size() > CGOptions::max_size()) {
+    conflict_msg_ = "--min-size cannot be larger than --max-size";
+    return true;
+  }
+  if (CGOptions::dfs_exhaustive()) {
+    conflict_msg_ =
+        "size and time budgets cannot be used with --dfs-exhaustive";
+    return true;
+  }
+  if (CGOptions::max_split_files() > 0) {
+    conflict_msg_ =
+        "size and time budgets cannot be used with --max-split-files";
+    return true;
+  }
+  return false;
+}
+
 bool CGOptions::has_extension_conflict() {
   int count = 0;
   if (CGOptions::klee())
@@ -491,6 +602,12 @@ bool CGOptions::has_conflict(void) {
   if (CGOptions::has_delta_conflict())
     return true;
 
+  if (CGOptions::has_batch_conflict())
+    return true;
+
+  if (CGOptions::has_budget_conflict())
+    return true;
+
   if ((CGOptions::inline_function_prob() < 0) ||
       (CGOptions::inline_function_prob() > 100)) {
     conflict_msg_ = "inline-function-prob value must between [0,100]";
@@ -518,6 +635,108 @@ bool CGOptions::has_conflict(void) {
     return true;
   }
 
+  if (CGOptions::checksum_kind() != CGOPTIONS_DEFAULT_CHECKSUM_KIND &&
+      CGOptions::step_hash_by_stmt()) {
+    conflict_msg_ = "--checksum-kind cannot be used with --step-hash-by-stmt";
+    return true;
+  }
+
+  if (CGOptions::self_contained()) {
+    if (CGOptions::dfs_exhaustive() || CGOptions::max_split_files() > 0) {
+      conflict_msg_ = "--self-contained cannot be used with --dfs-exhaustive "
+                      "or --max-split-files";
+      return true;
+    }
+    if (CGOptions::math_notmp()) {
+      conflict_msg_ = "--self-contained cannot be used with --math-notmp";
+      return true;
+    }
+  }
+
+  if (CGOptions::output_fd() != CGOPTIONS_DEFAULT_OUTPUT_FD) {
+    if (!CGOptions::output_file().empty() || !CGOptions::batch_dir().empty()) {
+      conflict_msg_ = "--output-fd cannot be used with --output or "
+                      "--batch-dir";
+      return true;
+    }
+    if (CGOptions::dfs_exhaustive() || CGOptions::max_split_files() > 0) {
+      conflict_msg_ = "--output-fd cannot be used with --dfs-exhaustive or "
+                      "--max-split-files";
+      return true;
+    }
+  }
+
+  if (CGOptions::dfs_shard_count() > 1 ||
+      !CGOptions::dfs_shard_dir().empty()) {
+    if (!CGOptions::dfs_exhaustive()) {
+      conflict_msg_ = "--dfs-shard can only be used with --dfs-exhaustive";
+      return true;
+    }
+    if (!CGOptions::dfs_debug_sequence().empty() ||
+        !CGOptions::dfs_replay().empty()) {
+      conflict_msg_ = "--dfs-shard cannot be used with --dfs-debug-sequence "
+                      "or --dfs-replay";
+      return true;
+    }
+  }
+
+  if (!CGOptions::dfs_checkpoint().empty() ||
+      !CGOptions::dfs_resume().empty()) {
+    if (!CGOptions::dfs_exhaustive()) {
+      conflict_msg_ = "--dfs-checkpoint and --dfs-resume can only be used "
+                      "with --dfs-exhaustive";
+      return true;
+    }
+    if (!CGOptions::dfs_debug_sequence().empty() ||
+        !CGOptions::dfs_replay().empty()) {
+      conflict_msg_ = "--dfs-checkpoint and --dfs-resume cannot be used with "
+                      "--dfs-debug-sequence or --dfs-replay";
+      return true;
+    }
+  }
+
+  if (CGOptions::dfs_unique()) {
+    if (!CGOptions::dfs_exhaustive()) {
+      conflict_msg_ = "--dfs-unique can only be used with --dfs-exhaustive";
+      return true;
+    }
+    // a resumed search must know the programs written before the checkpoint
+    if ((!CGOptions::dfs_checkpoint().empty() ||
+         !CGOptions::dfs_resume().empty()) &&
+        CGOptions::dfs_unique_file().empty()) {
+      conflict_msg_ = "--dfs-unique needs --dfs-unique-file with "
+                      "--dfs-checkpoint or --dfs-resume";
+      return true;
+    }
+  }
+
+  if (!CGOptions::dfs_trace().empty() || !CGOptions::dfs_replay().empty()) {
+    if (!CGOptions::dfs_exhaustive()) {
+      conflict_msg_ = "--dfs-trace and --dfs-replay can only be used with "
+                      "--dfs-exhaustive";
+      return true;
+    }
+    if (!CGOptions::dfs_replay().empty() &&
+        (!CGOptions::dfs_debug_sequence().empty() ||
+         !CGOptions::dfs_trace().empty() || CGOptions::dfs_unique())) {
+      conflict_msg_ = "--dfs-replay cannot be used with --dfs-debug-sequence, "
+                      "--dfs-trace or --dfs-unique";
+      return true;
+    }
+  }
+
+  if (CGOptions::tailored_safe_math()) {
+    if (CGOptions::dfs_exhaustive() || CGOptions::max_split_files() > 0) {
+      conflict_msg_ = "--tailored-safe-math cannot be used with "
+                      "--dfs-exhaustive or --max-split-files";
+      return true;
+    }
+    if (CGOptions::math_notmp()) {
+      conflict_msg_ = "--tailored-safe-math cannot be used with --math-notmp";
+      return true;
+    }
+  }
+
   if (CGOptions::func1_max_params() > CGOptions::max_params()) {
     conflict_msg_ = "func1_max_params() cannot be larger than max_params()";
     return true;
@@ -55,10 +55,15 @@ inline constexpr int CGOPTIONS_DEFAULT_MAX_ARRAY_LENGTH_PER_DIMENSION = 10;
 inline constexpr int CGOPTIONS_DEFAULT_MAX_ARRAY_LENGTH = 256;
 inline constexpr int CGOPTIONS_DEFAULT_MAX_ARRAY_NUM_IN_LOOP = 4;
 inline constexpr int CGOPTIONS_DEFAULT_MAX_EXHAUSTIVE_DEPTH = -1;
+// seconds between two checkpoints of an exhaustive search
+inline constexpr int CGOPTIONS_DEFAULT_DFS_CHECKPOINT_INTERVAL = 60;
 // 0 means we output to the standard output
 inline constexpr int CGOPTIONS_DEFAULT_MAX_SPLIT_FILES = 0;
 inline constexpr const char CGOPTIONS_DEFAULT_SPLIT_FILES_DIR[] = "./output";
 inline constexpr const char CGOPTIONS_DEFAULT_OUTPUT_FILE[] = "";
+// stdout
+inline constexpr int CGOPTIONS_DEFAULT_OUTPUT_FD = 1;
+inline constexpr const char CGOPTIONS_DEFAULT_CHECKSUM_KIND[] = "crc32";
 inline constexpr const char PLATFORM_CONFIG_FILE[] = "platform.info";
 
 /*
@@ -69,6 +74,18 @@ public:
   static bool compute_hash(void);
   static bool compute_hash(bool p);
 
+  static std::string checksum_kind(void);
+  static std::string checksum_kind(const std::string &p);
+
+  static bool bulk_array_hash(void);
+  static bool bulk_array_hash(bool p);
+
+  static bool self_contained(void);
+  static bool self_contained(bool p);
+
+  static bool tailored_safe_math(void);
+  static bool tailored_safe_math(bool p);
+
   static bool depth_protect(void);
   static bool depth_protect(bool p);
 
@@ -81,6 +98,30 @@ public:
   static std::string output_file(void);
   static std::string output_file(const std::string &p);
 
+  static int output_fd(void);
+  static int output_fd(int p);
+
+  static int batch_count(void);
+  static int batch_count(int p);
+
+  static std::string batch_dir(void);
+  static std::string batch_dir(const std::string &p);
+
+  static int jobs(void);
+  static int jobs(int p);
+
+  static std::string stats_json(void);
+  static std::string stats_json(const std::string &p);
+
+  static int min_size(void);
+  static int min_size(int p);
+
+  static int max_size(void);
+  static int max_size(int p);
+
+  static int max_gen_ms(void);
+  static int max_gen_ms(int p);
+
   static int max_funcs(void);
   static int max_funcs(int p);
 
@@ -171,6 +212,39 @@ public:
   static int max_exhaustive_depth(void);
   static int max_exhaustive_depth(int p);
 
+  static int dfs_shard_index(void);
+  static int dfs_shard_index(int p);
+
+  static int dfs_shard_count(void);
+  static int dfs_shard_count(int p);
+
+  static std::string dfs_shard_dir(void);
+  static std::string dfs_shard_dir(const std::string &p);
+
+  static std::string dfs_checkpoint(void);
+  static std::string dfs_checkpoint(const std::string &p);
+
+  static int dfs_checkpoint_interval(void);
+  static int dfs_checkpoint_interval(int p);
+
+  static std::string dfs_resume(void);
+  static std::string dfs_resume(const std::string &p);
+
+  static bool dfs_unique(void);
+  static bool dfs_unique(bool p);
+
+  static std::string dfs_unique_file(void);
+  static std::string dfs_unique_file(const std::string &p);
+
+  static std::string dfs_trace(void);
+  static std::string dfs_trace(const std::string &p);
+
+  static std::string dfs_replay(void);
+  static std::string dfs_replay(const std::string &p);
+
+  static int dfs_replay_index(void);
+  static int dfs_replay_index(int p);
+
   static bool compact_output(void);
   static bool compact_output(bool p);
 
@@ -488,17 +562,33 @@ private:
 
   static bool has_delta_conflict();
 
+  static bool has_batch_conflict();
+
+  static bool has_budget_conflict();
+
   static bool has_extension_conflict();
 
   static void parse_string_options(const string &vname, vector<std::string> &v);
 
   // Until I do this right, just make them all static.
   static bool compute_hash_;
+  static std::string checksum_kind_;
+  static bool bulk_array_hash_;
+  static bool self_contained_;
+  static bool tailored_safe_math_;
   static bool depth_protect_;
   static int max_funcs_;
   static int max_split_files_;
   static std::string split_files_dir_;
   static std::string output_file_;
+  static int output_fd_;
+  static int batch_count_;
+  static std::string batch_dir_;
+  static int jobs_;
+  static std::string stats_json_;
+  static int min_size_;
+  static int max_size_;
+  static int max_gen_ms_;
   static int max_params_;
   static int max_block_size_;
   static int max_blk_depth_;
@@ -531,6 +621,17 @@ private:
   static bool dfs_exhaustive_;
   static std::string dfs_debug_sequence_;
   static int max_exhaustive_depth_;
+  static int dfs_shard_index_;
+  static int dfs_shard_count_;
+  static std::string dfs_shard_dir_;
+  static std::string dfs_checkpoint_;
+  static int dfs_checkpoint_interval_;
+  static std::string dfs_resume_;
+  static bool dfs_unique_;
+  static std::string dfs_unique_file_;
+  static std::string dfs_trace_;
+  static std::string dfs_replay_;
+  static int dfs_replay_index_;
   static bool compact_output_;
   static int func1_max_params_;
   static bool klee_;
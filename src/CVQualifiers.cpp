@@ -42,6 +42,12 @@
 #include <cassert>
 #include <iostream>
 
+thread_local bool CVQualifiers::force_exact_match = false;
+
+bool CVQualifiers::match_exact(void) {
+  return CGOptions::match_exact_qualifiers() || force_exact_match;
+}
+
 //////////////////////////////////////////////////////////////////////
 // Construction/Destruction
 //////////////////////////////////////////////////////////////////////
@@ -138,7 +144,7 @@ bool CVQualifiers::match(const CVQualifiers &qfer) const {
   if (wildcard) {
     return true;
   }
-  if (CGOptions::match_exact_qualifiers()) {
+  if (CVQualifiers::match_exact()) {
     return is_consts == qfer.get_consts() &&
            is_volatiles == qfer.get_volatiles();
   }
@@ -375,7 +381,7 @@ CVQualifiers CVQualifiers::random_qualifiers(const Type *t,
 vector<bool> CVQualifiers::random_stricter_consts(void) const {
   vector<bool> consts;
   size_t depth = is_consts.size();
-  if (CGOptions::match_exact_qualifiers())
+  if (CVQualifiers::match_exact())
     return is_consts;
   for (size_t i = 0; i < depth; i++) {
     // special case
@@ -399,7 +405,7 @@ vector<bool> CVQualifiers::random_stricter_consts(void) const {
 vector<bool> CVQualifiers::random_stricter_volatiles(void) const {
   vector<bool> volatiles;
   size_t depth = is_volatiles.size();
-  if (CGOptions::match_exact_qualifiers())
+  if (CVQualifiers::match_exact())
     return is_volatiles;
   for (size_t i = 0; i < depth; i++) {
     // first one (storage must match, any level followed by at least two more
@@ -422,7 +428,7 @@ vector<bool> CVQualifiers::random_stricter_volatiles(void) const {
 vector<bool> CVQualifiers::random_looser_consts(void) const {
   vector<bool> consts;
   size_t depth = is_consts.size();
-  if (CGOptions::match_exact_qualifiers())
+  if (CVQualifiers::match_exact())
     return is_consts;
   for (size_t i = 0; i < depth; i++) {
     // special case
@@ -441,7 +447,7 @@ vector<bool> CVQualifiers::random_looser_consts(void) const {
 vector<bool> CVQualifiers::random_looser_volatiles(void) const {
   vector<bool> volatiles;
   size_t depth = is_volatiles.size();
-  if (CGOptions::match_exact_qualifiers())
+  if (CVQualifiers::match_exact())
     return is_volatiles;
   for (size_t i = 0; i < depth; i++) {
     if (!is_volatiles[i] || (i == 0 && depth > 1) || (depth - i > 2)) {
@@ -465,7 +471,7 @@ void CVQualifiers::add_qualifiers(bool is_const, bool is_volatile) {
 // actually add qualifiers to pointers
 CVQualifiers CVQualifiers::random_add_qualifiers(bool no_volatile) const {
   CVQualifiers qfer = *this;
-  if (CGOptions::match_exact_qualifiers()) {
+  if (CVQualifiers::match_exact()) {
     qfer.add_qualifiers(false, false);
     return qfer;
   }
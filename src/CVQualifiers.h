@@ -99,7 +99,13 @@ public:
   bool wildcard;
   bool accept_stricter;
 
+  // when set, qualifiers must match exactly, as with
+  // --match-exact-qualifiers. Used when selecting the lhs of assignments.
+  static thread_local bool force_exact_match;
+
 private:
+  static bool match_exact(void);
+
   // Type qualifiers.
   vector<bool> is_consts;
   vector<bool> is_volatiles;
@@ -0,0 +1,836 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2026 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+// csmith_test: a parallel version of scripts/compiler_test.pl. Every test
+// generates a program with csmith, compiles it with each compiler of the
+// configuration file and, with --with-wrong-code-bugs, runs the executables
+// and compares their checksums. The steps of all the tests in flight are
+// scheduled on a TaskPool, so generation, compilation and execution overlap
+// on every core. Each test works in a temporary directory of its own, so
+// several copies can share a working directory.
+
+#include <config.h>
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ResultsDb.h"
+#include "TaskPool.h"
+
+using namespace std;
+namespace fs = std::filesystem;
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+struct Options {
+  unsigned long count = 0; // 0 for unlimited
+  bool run_programs = false;
+  unsigned long jobs = 0;
+  string csmith;
+  string csmith_options = "--bitfields --packed-struct";
+  vector<string> includes;
+  string work_dir = ".";
+  // programs shorter than this many bytes are too boring to test
+  unsigned long min_size = 8000;
+  // timeouts in seconds
+  unsigned long csmith_timeout = 90;
+  unsigned long compiler_timeout = 120;
+  unsigned long program_timeout = 8;
+  string results_db;
+};
+
+Options opts;
+vector<string> compilers;
+string header;
+
+// set by SIGINT and SIGTERM: no new test is started and the running commands
+// are killed
+volatile sig_atomic_t interrupted = 0;
+
+void on_signal(int) { interrupted = 1; }
+
+///////////////////////////////////////////////////////////////////////////////
+
+enum class eRunStatus {
+  eOk,          // exited, with any exit code
+  eCrashed,     // killed by a signal
+  eTimedOut,    // killed after the timeout
+  eCantExecute, // fork or waitpid failed
+  eInterrupted, // killed because csmith_test was interrupted
+};
+
+struct RunResult {
+  eRunStatus status;
+  int exit_code;
+};
+
+/*
+ * Run cmd with /bin/sh in dir, with its stdout and stderr going to the file
+ * out in dir. The command gets a process group of its own, which is killed
+ * after timeout seconds.
+ */
+RunResult run_command(const string &cmd, const string &dir, const string &out,
+                      unsigned long timeout) {
+  // the child of a threaded process may only make async-signal-safe calls,
+  // so everything is prepared here
+  const string out_path = dir + "/" + out;
+  const char *c_cmd = cmd.c_str();
+  const char *c_dir = dir.c_str();
+  const char *c_out = out_path.c_str();
+  const pid_t pid = fork();
+  if (pid < 0)
+    return {eRunStatus::eCantExecute, -1};
+  if (pid == 0) {
+    setpgid(0, 0);
+    const int fd = open(c_out, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    const int null_fd = open("/dev/null", O_RDONLY);
+    if (fd < 0 || null_fd < 0 || chdir(c_dir) != 0)
+      _exit(127);
+    dup2(null_fd, 0);
+    dup2(fd, 1);
+    dup2(fd, 2);
+    close(fd);
+    close(null_fd);
+    execl("/bin/sh", "sh", "-c", c_cmd, static_cast<char *>(nullptr));
+    _exit(127);
+  }
+  // also done here, so that the group exists when we kill it
+  setpgid(pid, pid);
+
+  const auto deadline = chrono::steady_clock::now() + chrono::seconds(timeout);
+  auto pause = chrono::milliseconds(1);
+  int status = 0;
+  for (;;) {
+    const pid_t r = waitpid(pid, &status, WNOHANG);
+    if (r == pid)
+      break;
+    if (r < 0 && errno != EINTR)
+      return {eRunStatus::eCantExecute, -1};
+    const bool timed_out = chrono::steady_clock::now() >= deadline;
+    if (timed_out || interrupted) {
+      kill(-pid, SIGKILL);
+      while (waitpid(pid, &status, 0) < 0 && errno == EINTR) {
+      }
+      return {timed_out ? eRunStatus::eTimedOut : eRunStatus::eInterrupted,
+              -1};
+    }
+    this_thread::sleep_for(pause);
+    pause = min(pause * 2, chrono::milliseconds(50));
+  }
+  if (WIFSIGNALED(status))
+    return {eRunStatus::eCrashed, -1};
+  return {eRunStatus::eOk, WEXITSTATUS(status)};
+}
+
+// what follows key on the first line of the file containing it, or ""
+string read_value_from_file(const string &fn, const string &key) {
+  ifstream in(fn.c_str());
+  string line;
+  while (getline(in, line)) {
+    if (!line.empty() && line.back() == '\r')
+      line.pop_back();
+    const size_t pos = line.find(key);
+    if (pos != string::npos)
+      return line.substr(pos + key.size());
+  }
+  return "";
+}
+
+void write_bug_desc_to_file(const string &fn, const string &desc) {
+  ofstream out(fn.c_str(), ios::app);
+  out << "/* " << desc << " */" << endl;
+}
+
+/*
+ * The line of a compiler's output that best tells what went wrong, with the
+ * parts that change from one test program to the next taken out, so that
+ * the messages of the same bug compare equal
+ */
+string crash_message(const string &fn) {
+  ifstream in(fn.c_str());
+  string line, ice, error, last;
+  while (getline(in, line)) {
+    if (!line.empty() && line.back() == '\r')
+      line.pop_back();
+    if (line.empty())
+      continue;
+    if (line.find("internal compiler error") != string::npos) {
+      ice = line;
+      break;
+    }
+    if (error.empty() && line.find("error") != string::npos)
+      error = line;
+    last = line;
+  }
+  string msg = !ice.empty() ? ice : !error.empty() ? error : last;
+  static const regex location("[^ ]*test\\.c:[0-9]+(:[0-9]+)?: *");
+  static const regex suffix("_[0-9]+");
+  static const regex address("0x[0-9a-fA-F]+");
+  msg = regex_replace(msg, location, "");
+  msg = regex_replace(msg, suffix, "_N");
+  msg = regex_replace(msg, address, "0xN");
+  const size_t max_len = 200;
+  if (msg.size() > max_len)
+    msg.resize(max_len);
+  return msg;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+ * Outcome of compiling and running a test program with one compiler, as in
+ * compile_and_run of compiler_test.pl
+ */
+enum class eCompileResult {
+  eNormal,
+  eCompilerCrash,
+  eCompilerHang,
+  eProgramCrash,
+  eProgramHang,
+  eInterrupted,
+};
+
+const char *result_name(eCompileResult r) {
+  switch (r) {
+  case eCompileResult::eNormal:
+    return "normal";
+  case eCompileResult::eCompilerCrash:
+    return "compiler-crash";
+  case eCompileResult::eCompilerHang:
+    return "compiler-hang";
+  case eCompileResult::eProgramCrash:
+    return "program-crash";
+  case eCompileResult::eProgramHang:
+    return "program-hang";
+  case eCompileResult::eInterrupted:
+    break;
+  }
+  return "interrupted";
+}
+
+struct Outcome {
+  eCompileResult result = eCompileResult::eNormal;
+  int compiler_exit = -1;
+  int program_exit = -1;
+  long compile_ms = 0;
+  long run_ms = 0;
+  string checksum;
+  string message; // of a crashing compiler
+};
+
+/*
+ * Outcome of a test, as returned by evaluate_program of compiler_test.pl
+ */
+enum class eTestResult {
+  eProgramCrash, // a likely wrong-code bug
+  eProgramHang,  // not interesting, and not counted
+  eNormal,       // no compiler error found
+  eCompilerCrash,
+  eWrongCode,
+  eAborted, // interrupted, or csmith_test failed; not counted
+};
+
+struct Test {
+  string dir;
+  string seed;
+  uintmax_t size = 0;
+  // printed with the result, so that the lines of a test stay together
+  string msgs;
+  vector<Outcome> outcomes;
+  vector<BugRecord> bugs;
+  atomic<size_t> remaining{0};
+
+  string cfile(void) const { return dir + "/test.c"; }
+};
+
+class Tester {
+public:
+  Tester(TaskPool &pool, ResultsDb *db) : pool_(pool), db_(db) {}
+
+  void start(void);
+  void report(void);
+
+private:
+  void generate(void);
+  void compile_and_run(const shared_ptr<Test> &test, size_t i);
+  eTestResult evaluate(Test &test);
+  void finish(Test *test, eTestResult ret);
+  void record(Test &test);
+  void submit_test(void);
+  string next_bug_file(const char *prefix, unsigned long &counter);
+
+  TaskPool &pool_;
+  ResultsDb *db_;
+
+  // guards the members below, and the output
+  mutex mutex_;
+  unsigned long counted_ = 0;
+  unsigned long in_flight_ = 0;
+  unsigned long good_ = 0;
+  unsigned long crash_bug_ = 0;
+  unsigned long wrongcode_bug_ = 0;
+  unsigned long csmith_bug_ = 0;
+};
+
+void Tester::start(void) {
+  // enough tests in flight to keep every worker busy while some of them wait
+  // for csmith
+  unsigned long n = 2 * opts.jobs;
+  if (opts.count != 0)
+    n = min(n, opts.count);
+  for (unsigned long i = 0; i < n; i++)
+    submit_test();
+}
+
+// called with mutex_ held, or before the pool runs
+void Tester::submit_test(void) {
+  in_flight_++;
+  pool_.submit([this] { generate(); });
+}
+
+// called with mutex_ held
+string Tester::next_bug_file(const char *prefix, unsigned long &counter) {
+  counter++;
+  ostringstream ss;
+  ss << opts.work_dir << "/" << prefix << counter << ".c";
+  return ss.str();
+}
+
+void Tester::generate(void) {
+  string dir = opts.work_dir + "/csmith_test.XXXXXX";
+  if (interrupted || !mkdtemp(&dir[0])) {
+    if (!interrupted)
+      cerr << "cannot create a directory in " << opts.work_dir << endl;
+    finish(nullptr, eTestResult::eAborted);
+    return;
+  }
+  auto test = make_shared<Test>();
+  test->dir = dir;
+  const string cfile = test->cfile();
+  const string cmd =
+      opts.csmith + " " + opts.csmith_options + " --output test.c";
+
+  // run csmith until it generates a big enough program
+  for (;;) {
+    error_code ec;
+    fs::remove(cfile, ec);
+    const RunResult r =
+        run_command(cmd, test->dir, "csmith.out", opts.csmith_timeout);
+    if (r.status == eRunStatus::eInterrupted) {
+      finish(test.get(), eTestResult::eAborted);
+      return;
+    }
+    test->seed = read_value_from_file(cfile, "Seed:");
+    test->seed.erase(0, test->seed.find_first_not_of(" \t"));
+    if (test->seed.empty() && r.status == eRunStatus::eOk) {
+      {
+        lock_guard<mutex> lock(mutex_);
+        cerr << "Random program " << cfile << " has no seed information!"
+             << endl;
+      }
+      interrupted = 1;
+      finish(test.get(), eTestResult::eAborted);
+      return;
+    }
+    if (r.status != eRunStatus::eOk) {
+      lock_guard<mutex> lock(mutex_);
+      cout << "CSMITH BUG FOUND: number " << csmith_bug_ << endl;
+      fs::copy_file(cfile, next_bug_file("csmith_bug_", csmith_bug_),
+                    fs::copy_options::overwrite_existing, ec);
+      continue;
+    }
+    test->size = fs::file_size(cfile, ec);
+    if (!ec && test->size >= opts.min_size)
+      break;
+  }
+  test->msgs = "seed= " + test->seed + ", size= " + to_string(test->size) +
+               "\n";
+
+  const size_t n = compilers.size();
+  test->outcomes.resize(n);
+  test->remaining = n;
+  for (size_t i = 0; i < n; i++)
+    pool_.submit([this, test, i] { compile_and_run(test, i); });
+}
+
+// milliseconds since start
+long elapsed_ms(chrono::steady_clock::time_point start) {
+  return static_cast<long>(chrono::duration_cast<chrono::milliseconds>(
+                               chrono::steady_clock::now() - start)
+                               .count());
+}
+
+void Tester::compile_and_run(const shared_ptr<Test> &test, size_t i) {
+  const string exe = "a.out" + to_string(i);
+  const string out = "out" + to_string(i) + ".log";
+  const string compiler_out = "compiler" + to_string(i) + ".out";
+  const string cmd = compilers[i] + " test.c " + header + " -o " + exe;
+  Outcome &o = test->outcomes[i];
+
+  auto start = chrono::steady_clock::now();
+  RunResult r =
+      run_command(cmd, test->dir, compiler_out, opts.compiler_timeout);
+  o.compile_ms = elapsed_ms(start);
+  o.compiler_exit = r.exit_code;
+  if (r.status == eRunStatus::eInterrupted) {
+    o.result = eCompileResult::eInterrupted;
+  } else if (r.status == eRunStatus::eTimedOut) {
+    o.result = eCompileResult::eCompilerHang;
+    o.message = "timeout";
+  } else if (r.status != eRunStatus::eOk ||
+             !fs::exists(test->dir + "/" + exe)) {
+    o.result = eCompileResult::eCompilerCrash;
+    o.message = crash_message(test->dir + "/" + compiler_out);
+    if (o.message.empty())
+      o.message = r.status == eRunStatus::eCrashed
+                      ? "killed by a signal"
+                      : "exit code " + to_string(r.exit_code);
+  } else if (opts.run_programs) {
+    start = chrono::steady_clock::now();
+    r = run_command("./" + exe, test->dir, out, opts.program_timeout);
+    o.run_ms = elapsed_ms(start);
+    o.program_exit = r.exit_code;
+    if (r.status == eRunStatus::eInterrupted)
+      o.result = eCompileResult::eInterrupted;
+    else if (r.status == eRunStatus::eTimedOut)
+      o.result = eCompileResult::eProgramHang;
+    else if (r.status != eRunStatus::eOk)
+      o.result = eCompileResult::eProgramCrash;
+    else
+      o.checksum = read_value_from_file(test->dir + "/" + out, "checksum = ");
+  }
+
+  // the last compiler to finish evaluates the test
+  if (test->remaining.fetch_sub(1) == 1)
+    finish(test.get(), evaluate(*test));
+}
+
+// the compilers that ran the program, grouped by the checksum they got
+string checksum_signature(const Test &test, const vector<size_t> &ran) {
+  vector<string> sums;
+  vector<string> groups;
+  for (size_t i : ran) {
+    const Outcome &o = test.outcomes[i];
+    const size_t g = find(sums.begin(), sums.end(), o.checksum) - sums.begin();
+    if (g == sums.size()) {
+      sums.push_back(o.checksum);
+      groups.push_back(compilers[i]);
+    } else {
+      groups[g] += ", " + compilers[i];
+    }
+  }
+  string sig;
+  for (const string &g : groups)
+    sig += (sig.empty() ? "" : " | ") + g;
+  return sig;
+}
+
+/*
+ * Look at the results of every compiler in order, as evaluate_program of
+ * compiler_test.pl does, record the findings in the test program and collect
+ * the bugs for the results database
+ */
+eTestResult Tester::evaluate(Test &test) {
+  const string cfile = test.cfile();
+  eTestResult ret = eTestResult::eNormal;
+  vector<size_t> ran;
+  bool diverged = false;
+  for (size_t i = 0; i < compilers.size(); i++) {
+    const Outcome &o = test.outcomes[i];
+    switch (o.result) {
+    case eCompileResult::eInterrupted:
+      return eTestResult::eAborted;
+    case eCompileResult::eCompilerCrash:
+    case eCompileResult::eCompilerHang:
+      write_bug_desc_to_file(cfile, "Compiler error! Can't compile with " +
+                                        compilers[i] + " " + header);
+      test.bugs.push_back(
+          {test.seed, result_name(o.result), compilers[i], o.message, ""});
+      ret = eTestResult::eCompilerCrash;
+      break;
+    case eCompileResult::eProgramCrash:
+      write_bug_desc_to_file(cfile, "random program crashed!");
+      test.bugs.push_back(
+          {test.seed, result_name(o.result), compilers[i], "", ""});
+      return eTestResult::eProgramCrash;
+    case eCompileResult::eProgramHang:
+      test.msgs += "random program hangs!\n";
+      return eTestResult::eProgramHang;
+    case eCompileResult::eNormal:
+      if (opts.run_programs) {
+        if (!ran.empty() &&
+            o.checksum != test.outcomes[ran[0]].checksum) {
+          ret = eTestResult::eWrongCode;
+          diverged = true;
+        }
+        ran.push_back(i);
+      }
+      break;
+    }
+  }
+  if (diverged) {
+    test.bugs.push_back(
+        {test.seed, "wrong-code", checksum_signature(test, ran), "", ""});
+  }
+  if (ret == eTestResult::eWrongCode) {
+    write_bug_desc_to_file(
+        cfile, "Found checksum difference between compiler implementations");
+    for (size_t i : ran)
+      write_bug_desc_to_file(cfile, compilers[i] + ": " +
+                                        test.outcomes[i].checksum);
+  }
+  if (ret != eTestResult::eNormal) {
+    write_bug_desc_to_file(cfile, "please refer to "
+                                  "http://embed.cs.utah.edu/csmith/using.html "
+                                  "on how to report a bug");
+  }
+  return ret;
+}
+
+// called with mutex_ held
+void Tester::record(Test &test) {
+  for (size_t i = 0; i < compilers.size(); i++) {
+    const Outcome &o = test.outcomes[i];
+    RunRecord r;
+    r.seed = test.seed;
+    r.options = opts.csmith_options;
+    r.compiler = compilers[i];
+    r.result = result_name(o.result);
+    r.compiler_exit = o.compiler_exit;
+    r.program_exit = o.program_exit;
+    r.checksum = o.checksum;
+    r.compile_ms = o.compile_ms;
+    r.run_ms = o.run_ms;
+    db_->add_run(r);
+  }
+}
+
+/*
+ * Report a finished test, as test_one of compiler_test.pl does, delete its
+ * directory and start the next test if more are needed. With a results
+ * database, a test program is only saved when one of its bugs is new.
+ */
+void Tester::finish(Test *test, eTestResult ret) {
+  lock_guard<mutex> lock(mutex_);
+  if (ret != eTestResult::eAborted) {
+    cout << test->msgs;
+    if (db_)
+      record(*test);
+    if (ret == eTestResult::eProgramHang) {
+      cout << "BAD PROGRAM: doesn't count towards goal." << endl;
+    } else {
+      good_++;
+      cout << "GOOD PROGRAM: number " << good_ << endl;
+      bool save = true;
+      if (db_ && !test->bugs.empty()) {
+        save = false;
+        for (const BugRecord &b : test->bugs)
+          save = save || db_->find_cluster(b) == ResultsDb::npos;
+      }
+      string file;
+      error_code ec;
+      if (ret == eTestResult::eCompilerCrash) {
+        cout << "COMPILER CRASH ERROR FOUND: number " << crash_bug_ << endl;
+        file = next_bug_file("crash", crash_bug_);
+      }
+      if (ret == eTestResult::eWrongCode ||
+          ret == eTestResult::eProgramCrash) {
+        cout << "LIKELY WRONG CODE ERROR FOUND: number " << wrongcode_bug_
+             << endl;
+        file = next_bug_file("wrong", wrongcode_bug_);
+      }
+      if (!file.empty() && save)
+        fs::copy_file(test->cfile(), file,
+                      fs::copy_options::overwrite_existing, ec);
+      if (db_) {
+        for (BugRecord &b : test->bugs) {
+          b.file = save ? file : "";
+          const size_t c = db_->add_bug(b);
+          const unsigned long hits = db_->cluster(c).hits;
+          cout << (hits == 1 ? "NEW" : "KNOWN") << " BUG: cluster " << c
+               << ", " << b.kind << " (" << hits
+               << (hits == 1 ? " hit" : " hits") << ")" << endl;
+        }
+      }
+      counted_++;
+    }
+    cout << endl;
+  }
+  if (test) {
+    error_code ec;
+    fs::remove_all(test->dir, ec);
+  }
+
+  in_flight_--;
+  if (!interrupted && (opts.count == 0 || counted_ + in_flight_ < opts.count))
+    submit_test();
+}
+
+void Tester::report(void) {
+  cout << "Total csmith errors found: " << csmith_bug_ << endl;
+  cout << "Total crash errors found: " << crash_bug_ << endl;
+  if (opts.run_programs)
+    cout << "Total wrong-code errors found: " << wrongcode_bug_ << endl;
+  if (db_)
+    cout << "Distinct bugs in " << opts.results_db << ": "
+         << db_->cluster_count() << endl;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// compile a trivial program with every compiler of the configuration file
+bool read_compilers(const string &config_file) {
+  ifstream in(config_file.c_str());
+  if (!in) {
+    cerr << "Cannot read configuration file " << config_file << "." << endl;
+    return false;
+  }
+  string dir = opts.work_dir + "/csmith_test.XXXXXX";
+  if (!mkdtemp(&dir[0])) {
+    cerr << "cannot create a directory in " << opts.work_dir << endl;
+    return false;
+  }
+  ofstream(dir + "/foo.c") << "int main() { return 0;}" << endl;
+
+  bool ok = true;
+  string line;
+  while (ok && getline(in, line)) {
+    const size_t pos = line.find_first_not_of(" \t\r");
+    if (pos == string::npos || line[pos] == '#')
+      continue;
+    const RunResult r = run_command(line + " foo.c", dir, "compiler.out",
+                                    opts.compiler_timeout);
+    if (r.status != eRunStatus::eOk || r.exit_code != 0) {
+      cerr << "cannot execute compiler " << line << endl;
+      ok = false;
+    }
+    compilers.push_back(line);
+  }
+  error_code ec;
+  fs::remove_all(dir, ec);
+  if (ok && compilers.empty()) {
+    cerr << "no compiler in " << config_file << endl;
+    ok = false;
+  }
+  return ok;
+}
+
+void usage(void) {
+  cout << "usage: csmith_test [options] <test_case_count>(0 for unlimited) "
+          "<config-file>"
+       << endl
+       << "       csmith_test --triage <file>" << endl
+       << endl;
+  cout << "Each line of the configuration file, like scripts/compiler_test.in, "
+          "is a compiler command."
+       << endl
+       << endl;
+  cout << "  --with-wrong-code-bugs: also run the programs and compare their "
+          "checksums."
+       << endl;
+  cout << "  -j, --jobs <num>: number of worker threads (default: the number "
+          "of cores)."
+       << endl;
+  cout << "  --csmith <path>: the csmith to run (default: the one built with "
+          "csmith_test, or $CSMITH_HOME/src/csmith)."
+       << endl;
+  cout << "  --csmith-options <options>: options passed to csmith (default: "
+          "\"--bitfields --packed-struct\")."
+       << endl;
+  cout << "  -I <dir>: where the compilers find csmith.h; may be repeated "
+          "(default: the runtime directories of the build, or "
+          "$CSMITH_HOME/runtime)."
+       << endl;
+  cout << "  --work-dir <dir>: where the temporary directories and the bug "
+          "reports go (default: .)."
+       << endl;
+  cout << "  --results-db <file>: append the result of every test and "
+          "compiler to <file>, cluster the bugs found, and only save the test "
+          "programs of new bugs."
+       << endl;
+  cout << "  --triage <file>: list the bug clusters of a results database, "
+          "most different first, and exit."
+       << endl;
+  cout << "  --min-size <bytes>: regenerate programs smaller than this "
+          "(default: 8000)."
+       << endl;
+  cout << "  --csmith-timeout <secs>, --compiler-timeout <secs>, "
+          "--program-timeout <secs>: kill csmith, a compiler or a test "
+          "program after this long (default: 90, 120 and 8)."
+       << endl;
+}
+
+bool parse_ulong(const char *arg, unsigned long &val) {
+  char *end = nullptr;
+  errno = 0;
+  val = strtoul(arg, &end, 10);
+  if (errno != 0 || end == arg || *end != '\0' || arg[0] == '-') {
+    cerr << "invalid number: " << arg << endl;
+    return false;
+  }
+  return true;
+}
+
+} // namespace
+
+///////////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char **argv) {
+  vector<const char *> args;
+  for (int i = 1; i < argc; i++) {
+    const bool has_value = i + 1 < argc;
+    if (strcmp(argv[i], "--help") == 0 || strcmp(argv[i], "-h") == 0) {
+      usage();
+      return 0;
+    } else if (strcmp(argv[i], "--with-wrong-code-bugs") == 0) {
+      opts.run_programs = true;
+    } else if ((strcmp(argv[i], "--jobs") == 0 || strcmp(argv[i], "-j") == 0) &&
+               has_value) {
+      if (!parse_ulong(argv[++i], opts.jobs) || opts.jobs == 0)
+        return -1;
+    } else if (strcmp(argv[i], "--csmith") == 0 && has_value) {
+      opts.csmith = argv[++i];
+    } else if (strcmp(argv[i], "--csmith-options") == 0 && has_value) {
+      opts.csmith_options = argv[++i];
+    } else if (strcmp(argv[i], "-I") == 0 && has_value) {
+      opts.includes.push_back(argv[++i]);
+    } else if (strcmp(argv[i], "--work-dir") == 0 && has_value) {
+      opts.work_dir = argv[++i];
+    } else if (strcmp(argv[i], "--results-db") == 0 && has_value) {
+      opts.results_db = argv[++i];
+    } else if (strcmp(argv[i], "--triage") == 0 && has_value) {
+      ResultsDb db;
+      if (!db.load(argv[++i])) {
+        cerr << "cannot read " << argv[i] << endl;
+        return -1;
+      }
+      db.OutputTriage(cout);
+      return 0;
+    } else if (strcmp(argv[i], "--min-size") == 0 && has_value) {
+      if (!parse_ulong(argv[++i], opts.min_size))
+        return -1;
+    } else if (strcmp(argv[i], "--csmith-timeout") == 0 && has_value) {
+      if (!parse_ulong(argv[++i], opts.csmith_timeout))
+        return -1;
+    } else if (strcmp(argv[i], "--compiler-timeout") == 0 && has_value) {
+      if (!parse_ulong(argv[++i], opts.compiler_timeout))
+        return -1;
+    } else if (strcmp(argv[i], "--program-timeout") == 0 && has_value) {
+      if (!parse_ulong(argv[++i], opts.program_timeout))
+        return -1;
+    } else if (argv[i][0] == '-' && argv[i][1] != '\0') {
+      usage();
+      return -1;
+    } else {
+      args.push_back(argv[i]);
+    }
+  }
+  if (args.size() != 2 || !parse_ulong(args[0], opts.count)) {
+    usage();
+    return -1;
+  }
+
+  // the same defaults as compiler_test.pl when CSMITH_HOME is set
+  const char *home = getenv("CSMITH_HOME");
+  if (opts.csmith.empty())
+    opts.csmith = home ? string(home) + "/src/csmith" : CSMITH_TEST_CSMITH;
+  if (opts.includes.empty()) {
+    if (home) {
+      opts.includes.push_back(string(home) + "/runtime");
+    } else {
+      opts.includes.push_back(CSMITH_TEST_RUNTIME_SOURCE_DIR);
+      opts.includes.push_back(CSMITH_TEST_RUNTIME_BINARY_DIR);
+    }
+  }
+  // the commands run in the directories of the tests
+  opts.csmith = fs::absolute(opts.csmith).string();
+  for (const string &dir : opts.includes)
+    header += (header.empty() ? "-I" : " -I") + fs::absolute(dir).string();
+  if (!fs::exists(opts.csmith)) {
+    cerr << "cannot find csmith at " << opts.csmith << endl;
+    return -1;
+  }
+  if (opts.jobs == 0)
+    opts.jobs = max(1u, thread::hardware_concurrency());
+
+  struct sigaction sa;
+  memset(&sa, 0, sizeof(sa));
+  sa.sa_handler = on_signal;
+  sigemptyset(&sa.sa_mask);
+  sigaction(SIGINT, &sa, nullptr);
+  sigaction(SIGTERM, &sa, nullptr);
+
+  if (!read_compilers(args[1]))
+    return -1;
+  if (opts.run_programs)
+    cout << "Finding both crash bugs and wrong-code bugs" << endl;
+
+  ResultsDb db;
+  if (!opts.results_db.empty() && !db.open(opts.results_db)) {
+    cerr << "cannot write to " << opts.results_db << endl;
+    return -1;
+  }
+
+  TaskPool pool(static_cast<unsigned>(opts.jobs));
+  Tester tester(pool, opts.results_db.empty() ? nullptr : &db);
+  tester.start();
+  pool.run();
+  tester.report();
+  return interrupted ? 1 : 0;
+}
+
+// Local Variables:
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+
+// End of file.
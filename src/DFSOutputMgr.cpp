@@ -40,11 +40,11 @@
 
 using namespace std;
 
-DFSOutputMgr *DFSOutputMgr::instance_ = nullptr;
+thread_local DFSOutputMgr *DFSOutputMgr::instance_ = nullptr;
 
-DFSOutputMgr::DFSOutputMgr() {}
+DFSOutputMgr::DFSOutputMgr() : main_out_(&std::cout) {}
 
-DFSOutputMgr::~DFSOutputMgr() {}
+DFSOutputMgr::~DFSOutputMgr() { DFSOutputMgr::instance_ = nullptr; }
 
 DFSOutputMgr *DFSOutputMgr::CreateInstance() {
   if (DFSOutputMgr::instance_)
@@ -89,7 +89,7 @@ void DFSOutputMgr::Output() {
     OutputMain(out);
 }
 
-std::ostream &DFSOutputMgr::get_main_out() { return std::cout; }
+std::ostream &DFSOutputMgr::get_main_out() { return *main_out_; }
 
 void DFSOutputMgr::outputln(ostream &out) {
   if (!CGOptions::compact_output())
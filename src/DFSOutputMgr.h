@@ -54,14 +54,19 @@ public:
 
   virtual void output_tab(ostream &out, int indent) override;
 
+  // Where Output() and OutputHeader() write, std::cout by default.
+  void set_main_out(std::ostream &out) { main_out_ = &out; }
+
 private:
   DFSOutputMgr();
 
   virtual std::ostream &get_main_out() override;
 
-  static DFSOutputMgr *instance_;
+  static thread_local DFSOutputMgr *instance_;
 
   std::string struct_output_;
+
+  std::ostream *main_out_;
 };
 
 #endif // DFS_OUTPUT_MGR_H
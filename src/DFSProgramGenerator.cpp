@@ -30,6 +30,7 @@
 #include <config.h>
 
 #include "AbsRndNumGenerator.h"
+#include "CGOptions.h"
 #include "DFSOutputMgr.h"
 #include "DFSProgramGenerator.h"
 #include "DFSRndNumGenerator.h"
@@ -37,19 +38,30 @@
 #include "Finalization.h"
 #include "Function.h"
 #include "PartialExpander.h"
+#include "Profiler.h"
 #include "RandomNumber.h"
+#include "SequenceTrace.h"
 #include "VariableSelector.h"
 #include "util.h"
 #include <cassert>
+#include <cctype>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
 #include <iostream>
 #include <sstream>
+#include <unistd.h>
+#include <unordered_map>
 
 using namespace std;
 
 DFSProgramGenerator::DFSProgramGenerator(int argc, char *argv[],
                                          unsigned long seed)
     : argc_(argc), argv_(argv), seed_(seed), good_count_(0),
-      output_mgr_(nullptr) {}
+      output_mgr_(nullptr), part_index_(0), unique_records_(0),
+      trace_bytes_(0), trace_flags_(0), trace_rand_state_(0) {}
 
 DFSProgramGenerator::~DFSProgramGenerator() {
   Finalization::doFinalization();
@@ -62,35 +74,379 @@ void DFSProgramGenerator::initialize() {
   assert(output_mgr_);
 }
 
+OutputMgr *DFSProgramGenerator::getOutputMgr() { return output_mgr_; }
+
 std::string DFSProgramGenerator::get_count_prefix(const std::string &name) {
   std::ostringstream ss;
   ss << "p_" << good_count_ << "_" << name;
   return ss.str();
 }
 
-void DFSProgramGenerator::goGenerator() {
-  DFSRndNumGenerator *impl =
-      dynamic_cast<DFSRndNumGenerator *>(RandomNumber::GetRndNumGenerator());
-  // unsigned long long count = 0;
-  GenerateAllTypes();
-  output_mgr_->OutputStructUnions(cout);
+/*
+ * Claim a part of the search for this process. Without --dfs-shard-dir, a
+ * process only searches its own parts and never competes for them.
+ */
+bool DFSProgramGenerator::claim_part(int part) {
+  const std::string &dir = CGOptions::dfs_shard_dir();
+  if (dir.empty())
+    return true;
+  std::ostringstream ss;
+  ss << dir << "/" << part;
+  int fd = open(ss.str().c_str(), O_WRONLY | O_CREAT | O_EXCL, 0644);
+  if (fd < 0) {
+    if (errno == EEXIST)
+      return false;
+    cerr << "cannot claim " << ss.str() << ": " << strerror(errno) << endl;
+    exit(-1);
+  }
+  close(fd);
+  return true;
+}
+
+void DFSProgramGenerator::search(DFSRndNumGenerator *impl) {
+  const bool checkpoints = !CGOptions::dfs_checkpoint().empty();
+  const std::chrono::seconds interval(CGOptions::dfs_checkpoint_interval());
   while (!impl->get_all_done()) {
     Error::set_error(SUCCESS);
-    GenerateFunctions();
-    if (Error::get_error() == SUCCESS) {
-      // count++;
-      // if (count >= 47376)
-      // cout << "here" << std::endl;
-      output_mgr_->OutputHeader(argc_, argv_, seed_);
-      output_mgr_->Output();
-      OutputMgr::really_outputln(cout);
-      good_count_++;
+    if (trace_out_.is_open()) {
+      trace_flags_ = RandomNumber::HasRndNumGenerator(
+                         RNDNUM_GENERATOR::rDefaultRndNumGenerator)
+                         ? 0
+                         : SequenceTrace::seeds_rand;
+      trace_rand_state_ = AbsRndNumGenerator::get_rand_state();
     }
+    GenerateFunctions();
+    if (Error::get_error() == SUCCESS && impl->in_part())
+      output_program(impl);
     impl->reset_state();
     Function::doFinalization();
     VariableSelector::doFinalization();
     reset_gensym();
     PartialExpander::restore_init_values();
-    // cout << "count = " << count << std::endl;
+    if (checkpoints &&
+        std::chrono::steady_clock::now() - last_checkpoint_ >= interval) {
+      save_checkpoint(impl);
+    }
+  }
+}
+
+/*
+ * A fingerprint of the text of a program that ignores its comments, its
+ * layout and the numbers the generator put in the names of its variables,
+ * functions and fields: those names are numbered again in the order they
+ * appear. Two programs with the same fingerprint are the same program up to a
+ * renaming. Constants are kept, they change what the program computes.
+ */
+static uint64_t program_fingerprint(const std::string &text) {
+  std::unordered_map<std::string, size_t> names;
+  uint64_t h = 14695981039346656037ull;
+  auto mix = [&h](const std::string &token) {
+    for (size_t k = 0; k < token.size(); ++k) {
+      h ^= static_cast<unsigned char>(token[k]);
+      h *= 1099511628211ull;
+    }
+    // keep "a b" apart from "ab"
+    h ^= ' ';
+    h *= 1099511628211ull;
+  };
+  const size_t n = text.size();
+  size_t i = 0;
+  while (i < n) {
+    const unsigned char c = text[i];
+    size_t j = i + 1;
+    if (isspace(c)) {
+      i = j;
+      continue;
+    }
+    if (c == '/' && j < n && text[j] == '*') {
+      size_t end = text.find("*/", j + 1);
+      i = end == std::string::npos ? n : end + 2;
+      continue;
+    }
+    if (c == '/' && j < n && text[j] == '/') {
+      size_t end = text.find('\n', j);
+      i = end == std::string::npos ? n : end + 1;
+      continue;
+    }
+    if (isalnum(c) || c == '_') {
+      while (j < n && (isalnum(static_cast<unsigned char>(text[j])) ||
+                       text[j] == '_'))
+        ++j;
+      std::string token = text.substr(i, j - i);
+      // the generated names end with a number: g_1, l_2, func_3, f4 ...
+      if (!isdigit(c) && isdigit(static_cast<unsigned char>(text[j - 1]))) {
+        auto it = names.insert(std::make_pair(token, names.size())).first;
+        std::string stem;
+        for (size_t k = 0; k < token.size(); ++k) {
+          if (!isdigit(static_cast<unsigned char>(token[k])))
+            stem += token[k];
+        }
+        token = stem + "#" + std::to_string(it->second);
+      }
+      mix(token);
+    } else {
+      mix(std::string(1, static_cast<char>(c)));
+    }
+    i = j;
+  }
+  return h;
+}
+
+/*
+ * Generate again the program of record --dfs-replay-index of the trace
+ * --dfs-replay, from its choices and the state of genrand it started from.
+ */
+void DFSProgramGenerator::replay(DFSRndNumGenerator *impl) {
+  const std::string &path = CGOptions::dfs_replay();
+  unsigned flags = 0;
+  uint64_t rand_state = 0;
+  if (!impl->load_trace(path, CGOptions::dfs_replay_index(), flags,
+                        rand_state)) {
+    cerr << "error: " << path << " has no record "
+         << CGOptions::dfs_replay_index() << endl;
+    exit(-1);
+  }
+  // as for --dfs-resume, unless the program created that generator itself
+  if (!(flags & SequenceTrace::seeds_rand)) {
+    RandomNumber::SwitchRndNumGenerator(RandomNumber::SwitchRndNumGenerator(
+        RNDNUM_GENERATOR::rDefaultRndNumGenerator));
+  }
+  AbsRndNumGenerator::set_rand_state(rand_state);
+  Error::set_error(SUCCESS);
+  GenerateFunctions();
+  if (Error::get_error() != SUCCESS) {
+    cerr << "error: record " << CGOptions::dfs_replay_index() << " of "
+         << path << " does not make a program with these options" << endl;
+    exit(-1);
+  }
+  output_program(impl);
+}
+
+/*
+ * Write the program just generated, and its choices to --dfs-trace. With
+ * --dfs-unique, it is rendered first and only written if no program with the
+ * same fingerprint was.
+ */
+void DFSProgramGenerator::output_program(DFSRndNumGenerator *impl) {
+  if (CGOptions::dfs_unique()) {
+    std::ostringstream body;
+    output_mgr_->set_main_out(body);
+    output_mgr_->Output();
+    output_mgr_->set_main_out(cout);
+    const uint64_t fingerprint = program_fingerprint(body.str());
+    if (!unique_.insert(fingerprint).second) {
+      Profiler::incr(eProfCounter::eDfsDuplicates);
+      return;
+    }
+    output_mgr_->OutputHeader(argc_, argv_, seed_);
+    cout << body.str();
+    if (unique_out_.is_open()) {
+      char record[8];
+      for (int k = 0; k < 8; ++k)
+        record[k] = static_cast<char>(fingerprint >> (8 * k));
+      unique_out_.write(record, sizeof(record));
+      unique_records_++;
+    }
+  } else {
+    output_mgr_->OutputHeader(argc_, argv_, seed_);
+    output_mgr_->Output();
+  }
+  OutputMgr::really_outputln(cout);
+  if (trace_out_.is_open()) {
+    trace_bytes_ += SequenceTrace::write(trace_out_, trace_flags_,
+                                         trace_rand_state_, impl->choices());
+  }
+  good_count_++;
+}
+
+/*
+ * Read the fingerprints of --dfs-unique-file, 8 bytes each with the lowest
+ * byte first, and open it to add those of the programs to come. A resumed
+ * search drops those added after its checkpoint, whose programs it writes
+ * again.
+ */
+void DFSProgramGenerator::open_unique_file(bool resume) {
+  const std::string &path = CGOptions::dfs_unique_file();
+  ifstream in(path.c_str(), ios::binary);
+  size_t records = 0;
+  char record[8];
+  while ((!resume || records < unique_records_) &&
+         in.read(record, sizeof(record))) {
+    uint64_t fingerprint = 0;
+    for (int k = 7; k >= 0; --k)
+      fingerprint = (fingerprint << 8) | static_cast<unsigned char>(record[k]);
+    unique_.insert(fingerprint);
+    records++;
+  }
+  if (resume ? records != unique_records_ : in.gcount() != 0) {
+    cerr << "error: " << path << " does not match the search" << endl;
+    exit(-1);
+  }
+  in.close();
+  unique_records_ = records;
+  unique_out_.open(path.c_str(), ios::binary | ios::app);
+  if (!unique_out_) {
+    cerr << "cannot open " << path << endl;
+    exit(-1);
+  }
+  if (resume && truncate(path.c_str(), records * sizeof(record)) != 0) {
+    cerr << "cannot truncate " << path << ": " << strerror(errno) << endl;
+    exit(-1);
+  }
+}
+
+/*
+ * Open --dfs-trace and write its header, or on resume, drop the records
+ * written after the checkpoint like open_unique_file does.
+ */
+void DFSProgramGenerator::open_trace_file(bool resume) {
+  const std::string &path = CGOptions::dfs_trace();
+  if (!resume) {
+    trace_out_.open(path.c_str(), ios::binary | ios::trunc);
+    SequenceTrace::write_header(trace_out_);
+    trace_bytes_ = sizeof(SequenceTrace::magic);
+  } else {
+    ifstream in(path.c_str(), ios::binary | ios::ate);
+    if (trace_bytes_ < sizeof(SequenceTrace::magic) || !in ||
+        static_cast<uint64_t>(in.tellg()) < trace_bytes_) {
+      cerr << "error: " << path << " does not match the search" << endl;
+      exit(-1);
+    }
+    in.close();
+    if (truncate(path.c_str(), trace_bytes_) != 0) {
+      cerr << "cannot truncate " << path << ": " << strerror(errno) << endl;
+      exit(-1);
+    }
+    trace_out_.open(path.c_str(), ios::binary | ios::app);
+  }
+  if (!trace_out_) {
+    cerr << "cannot open " << path << endl;
+    exit(-1);
+  }
+}
+
+/*
+ * A checkpoint is taken between two programs, where the whole state of the
+ * search is the part being searched, the number of programs so far (and of
+ * fingerprints in --dfs-unique-file, and of bytes in --dfs-trace) and the
+ * frontier of the generator. It replaces the previous one only once it is
+ * complete, so a run killed while writing it leaves the previous one.
+ */
+void DFSProgramGenerator::save_checkpoint(DFSRndNumGenerator *impl) {
+  const std::string &path = CGOptions::dfs_checkpoint();
+  const std::string tmp = path + ".tmp";
+  // the checkpoint promises that the programs before it were written
+  cout.flush();
+  unique_out_.flush();
+  trace_out_.flush();
+  ofstream out(tmp.c_str());
+  out << checkpoint_magic << "\n"
+      << CGOptions::max_exhaustive_depth() << " "
+      << CGOptions::dfs_shard_index() << " " << CGOptions::dfs_shard_count()
+      << "\n"
+      << part_index_ << " " << good_count_ << " " << unique_records_ << " "
+      << trace_bytes_ << "\n";
+  impl->save_state(out);
+  out.close();
+  if (!out || rename(tmp.c_str(), path.c_str()) != 0)
+    cerr << "warning: cannot write checkpoint " << path << endl;
+  last_checkpoint_ = std::chrono::steady_clock::now();
+}
+
+/*
+ * Read the checkpoint named by --dfs-resume, which must come from a search
+ * with the same depth and shard. Set the part and the numbers of programs,
+ * fingerprints and trace bytes from it and leave the frontier of the
+ * generator in `in'.
+ */
+void DFSProgramGenerator::read_checkpoint(std::ifstream &in) {
+  const std::string &path = CGOptions::dfs_resume();
+  in.open(path.c_str());
+  std::string magic;
+  int depth = 0, index = 0, count = 0;
+  if (!getline(in, magic) || magic != checkpoint_magic ||
+      !(in >> depth >> index >> count >> part_index_ >> good_count_ >>
+        unique_records_ >> trace_bytes_) ||
+      depth != CGOptions::max_exhaustive_depth() ||
+      index != CGOptions::dfs_shard_index() ||
+      count != CGOptions::dfs_shard_count()) {
+    cerr << "error: " << path << " is not a checkpoint of this search"
+         << endl;
+    exit(-1);
+  }
+}
+
+/*
+ * With --dfs-shard i/N, the search is split into parts_per_shard * N parts by
+ * the first choices of the programs (see DFSRndNumGenerator::in_part), and
+ * this process searches the parts p with p % N == i. The parts of a lopsided
+ * tree differ a lot in size, so with --dfs-shard-dir a process done with its
+ * own parts goes on with the parts nobody claimed yet, from the last one
+ * backwards while their owners go forwards. A checkpoint records the
+ * position in that order, so --dfs-resume continues inside the part it was
+ * taken in.
+ */
+void DFSProgramGenerator::goGenerator() {
+  DFSRndNumGenerator *impl =
+      dynamic_cast<DFSRndNumGenerator *>(RandomNumber::GetRndNumGenerator());
+  GenerateAllTypes();
+  output_mgr_->OutputStructUnions(cout);
+  if (!CGOptions::dfs_replay().empty()) {
+    replay(impl);
+    return;
+  }
+  const int shards = CGOptions::dfs_shard_count();
+  const int shard = CGOptions::dfs_shard_index();
+  const bool sharded = shards > 1 || !CGOptions::dfs_shard_dir().empty();
+  const int parts = shards * parts_per_shard;
+  // The parts in the order they are searched; a search that is not sharded
+  // is a single part.
+  vector<int> order;
+  if (!sharded) {
+    order.push_back(0);
+  } else {
+    for (int p = shard; p < parts; p += shards)
+      order.push_back(p);
+    for (int p = parts - 1; !CGOptions::dfs_shard_dir().empty() && p >= 0;
+         --p) {
+      if (p % shards != shard)
+        order.push_back(p);
+    }
+  }
+
+  ifstream resume;
+  part_index_ = 0;
+  if (!CGOptions::dfs_resume().empty())
+    read_checkpoint(resume);
+  if (!CGOptions::dfs_unique_file().empty())
+    open_unique_file(resume.is_open());
+  if (!CGOptions::dfs_trace().empty())
+    open_trace_file(resume.is_open());
+  last_checkpoint_ = std::chrono::steady_clock::now();
+  for (; part_index_ < order.size(); ++part_index_) {
+    const int part = order[part_index_];
+    if (resume.is_open()) {
+      // The generator behind pure_rnd_* seeds genrand when it is created,
+      // which the run being resumed did in its first program. Create it
+      // before restoring the state of genrand.
+      RandomNumber::SwitchRndNumGenerator(RandomNumber::SwitchRndNumGenerator(
+          RNDNUM_GENERATOR::rDefaultRndNumGenerator));
+      // the part was claimed before the checkpoint
+      if (sharded)
+        impl->restart(parts, part);
+      if (!impl->load_state(resume)) {
+        cerr << "error: " << CGOptions::dfs_resume()
+             << " is not a checkpoint of this search" << endl;
+        exit(-1);
+      }
+      resume.close();
+    } else if (sharded) {
+      if (!claim_part(part))
+        continue;
+      impl->restart(parts, part);
+    }
+    search(impl);
   }
+  if (!CGOptions::dfs_checkpoint().empty())
+    save_checkpoint(impl);
 }
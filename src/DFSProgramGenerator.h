@@ -30,10 +30,16 @@
 #ifndef DFS_PROGRAM_GENERATOR_H
 #define DFS_PROGRAM_GENERATOR_H
 
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <unordered_set>
+
 #include "AbsProgramGenerator.h"
 #include "Common.h"
 
-class OutputMgr;
+class DFSOutputMgr;
+class DFSRndNumGenerator;
 
 class DFSProgramGenerator : public AbsProgramGenerator {
 public:
@@ -41,7 +47,7 @@ public:
 
   virtual ~DFSProgramGenerator() override;
 
-  virtual OutputMgr *getOutputMgr() override { return output_mgr_; }
+  virtual OutputMgr *getOutputMgr() override;
 
   virtual void goGenerator() override;
 
@@ -50,6 +56,28 @@ public:
   virtual std::string get_count_prefix(const std::string &name) override;
 
 private:
+  // The number of parts of the search per --dfs-shard process.
+  static const int parts_per_shard = 8;
+
+  // The first line of a checkpoint file.
+  static constexpr const char *checkpoint_magic = "csmith-dfs-checkpoint 3";
+
+  bool claim_part(int part);
+
+  void search(DFSRndNumGenerator *impl);
+
+  void replay(DFSRndNumGenerator *impl);
+
+  void output_program(DFSRndNumGenerator *impl);
+
+  void open_unique_file(bool resume);
+
+  void open_trace_file(bool resume);
+
+  void save_checkpoint(DFSRndNumGenerator *impl);
+
+  void read_checkpoint(std::ifstream &in);
+
   int argc_;
 
   char **argv_;
@@ -58,7 +86,27 @@ private:
 
   INT64 good_count_;
 
-  OutputMgr *output_mgr_;
+  DFSOutputMgr *output_mgr_;
+
+  // The position of the part being searched in the search order.
+  size_t part_index_;
+
+  std::chrono::steady_clock::time_point last_checkpoint_;
+
+  // With --dfs-unique, the fingerprints of the programs written so far.
+  std::unordered_set<uint64_t> unique_;
+
+  // The --dfs-unique-file, and the number of fingerprints in it.
+  std::ofstream unique_out_;
+  size_t unique_records_;
+
+  // The --dfs-trace, and its size in bytes.
+  std::ofstream trace_out_;
+  uint64_t trace_bytes_;
+
+  // Where the program being generated starts from, for its trace record.
+  unsigned trace_flags_;
+  uint64_t trace_rand_state_;
 };
 
 #endif
@@ -31,7 +31,9 @@
 
 #include "DFSRndNumGenerator.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cstdlib>
 #include <iostream>
 #include <sstream>
 
@@ -41,6 +43,7 @@
 #include "Sequence.h"
 #include "SequenceFactory.h"
 #include "SequenceLineParser.h"
+#include "SequenceTrace.h"
 
 // Represents the data for each random choice
 class DFSRndNumGenerator::SearchState {
@@ -115,11 +118,12 @@ void DFSRndNumGenerator::SearchState::dump(const string &) {}
 #endif
 // ----------------------------------------------------------------------------------------------
 
-DFSRndNumGenerator *DFSRndNumGenerator::impl_ = 0;
+thread_local DFSRndNumGenerator *DFSRndNumGenerator::impl_ = 0;
 
 DFSRndNumGenerator::DFSRndNumGenerator(Sequence *concrete_seq)
     : trace_string_(""), decision_depth_(-1), current_pos_(-1),
-      all_done_(false), seq_(concrete_seq), use_debug_sequence_(false) {
+      all_done_(false), seq_(concrete_seq), use_debug_sequence_(false),
+      part_depth_(0), parts_(1), part_(0) {
   init_states(CGOptions::max_exhaustive_depth());
 }
 
@@ -129,6 +133,7 @@ DFSRndNumGenerator::~DFSRndNumGenerator() {
   }
   states_.clear();
   SequenceFactory::destroy_sequences();
+  impl_ = 0;
 }
 
 /*
@@ -235,20 +240,48 @@ bool DFSRndNumGenerator::filter_invalid_nums(vector<int> *invalid_nums, int v) {
   return (i != invalid_nums->end());
 }
 
+/*
+ * The part of the programs whose first choices are those at states_[0..pos-1]
+ * followed by v: an FNV-1a hash of the choices.
+ */
+int DFSRndNumGenerator::part_of(int pos, int v) {
+  unsigned int h = 2166136261u;
+  for (int i = 0; i <= pos; ++i) {
+    h ^= static_cast<unsigned int>(i < pos ? states_[i]->value() : v);
+    h *= 16777619u;
+  }
+  return static_cast<int>(h % parts_);
+}
+
+/*
+ * Choosing v at pos would leave the part being searched. Only the last of the
+ * choices deciding the part is restricted: the subtrees below it belong to a
+ * single part, the choices above it are shared by all the parts.
+ */
+bool DFSRndNumGenerator::outside_part(int pos, int v) {
+  if (parts_ <= 1 || pos != part_depth_ - 1)
+    return false;
+  return part_of(pos, v) != part_;
+}
+
 int DFSRndNumGenerator::random_choice(int bound, const Filter *filter,
                                       const string *where,
                                       vector<int> *invalid_nums) {
-  int err = Error::get_error();
-
-  if (err == BACKTRACKING_ERROR) {
+  // The program is abandoned on any error, but the callers do not all check
+  // for one before asking for their next choice.
+  if (Error::get_error() != SUCCESS)
     return -1;
-  } else if (err != SUCCESS) {
-    assert("request random number in an error state. " && 0);
-  }
 
   ++current_pos_;
   if (use_debug_sequence_) {
     int rv = seq_->get_number_by_pos(current_pos_);
+    // a trace records the bounds, which tell whether it still applies
+    int recorded = seq_->get_bound_by_pos(current_pos_);
+    if (recorded && recorded != bound) {
+      cerr << "error: choice " << current_pos_ << " of the trace has bound "
+           << recorded << ", but the program asks for " << bound << endl;
+      exit(-1);
+    }
     if (filter)
       filter->filter(rv);
     // cout << "current_pos _ = " << current_pos_ << ", length = " <<
@@ -288,7 +321,8 @@ int DFSRndNumGenerator::random_choice(int bound, const Filter *filter,
       current_pos_ = local_current_pos;
       decision_depth_ = local_decision_depth;
       ERROR_GUARD(-1);
-    } while (v < bound && ((filter && filter->filter(v)) ||
+    } while (v < bound && (outside_part(local_current_pos, v) ||
+                           (filter && filter->filter(v)) ||
                            filter_invalid_nums(invalid_nums, v)));
 
     state->set_value(v);
@@ -317,7 +351,8 @@ int DFSRndNumGenerator::random_choice(int bound, const Filter *filter,
     state->initSearchState(true, v, bound);
 
     while (v < bound &&
-           ((filter && (filter->filter(v))) ||
+           (outside_part(local_current_pos, v) ||
+            (filter && (filter->filter(v))) ||
             filter_invalid_nums(invalid_nums, v))) { // Filter out invalid value
       for (int i = decision_depth_; i < CGOptions::max_exhaustive_depth();
            ++i) {
@@ -381,6 +416,79 @@ void DFSRndNumGenerator::reset_state(void) {
   seq_->clear();
 }
 
+void DFSRndNumGenerator::restart(int parts, int part) {
+  for (auto i = states_.begin(); i != states_.end(); ++i) {
+    (*i)->initSearchState(false, 0, 0);
+  }
+  decision_depth_ = -1;
+  all_done_ = false;
+  // Deep enough for the parts to be small, shallow enough for most programs
+  // of the search to make that many choices (see in_part).
+  part_depth_ = std::max(1, std::min(8, CGOptions::max_exhaustive_depth() / 2));
+  parts_ = parts;
+  part_ = part;
+  reset_state();
+}
+
+/*
+ * A program that made all the choices deciding its part is in the part by
+ * construction. A shorter one is reached by the search of every part, so it
+ * is assigned to the part of its whole sequence of choices.
+ */
+bool DFSRndNumGenerator::in_part(void) {
+  if (parts_ <= 1 || current_pos_ >= part_depth_ - 1)
+    return true;
+  if (current_pos_ < 0)
+    return part_ == 0;
+  return part_of(current_pos_, states_[current_pos_]->value()) == part_;
+}
+
+/*
+ * Only the levels up to the last initialized one are saved: the deeper ones
+ * are visited for the first time by the next program. The constants of the
+ * programs come from genrand, so its state is part of the frontier.
+ */
+void DFSRndNumGenerator::save_state(std::ostream &out) {
+  int levels = static_cast<int>(states_.size());
+  while (levels > 0 && !states_[levels - 1]->init())
+    --levels;
+  out << decision_depth_ << " " << all_done_ << " " << get_rand_state() << " "
+      << levels << "\n";
+  for (int i = 0; i < levels; ++i) {
+    SearchState *state = states_[i];
+    out << state->init() << " " << state->value() << " " << state->bound()
+        << "\n";
+  }
+}
+
+bool DFSRndNumGenerator::load_state(std::istream &in) {
+  int levels = 0;
+  uint64_t rand_state = 0;
+  if (!(in >> decision_depth_ >> all_done_ >> rand_state >> levels) ||
+      levels < 0 ||
+      levels > static_cast<int>(states_.size()) ||
+      decision_depth_ >= static_cast<int>(states_.size()))
+    return false;
+  for (int i = 0; i < static_cast<int>(states_.size()); ++i) {
+    bool init = false;
+    int value = 0, bound = 0;
+    if (i < levels && !(in >> init >> value >> bound))
+      return false;
+    states_[i]->initSearchState(init, value, bound);
+  }
+  set_rand_state(rand_state);
+  reset_state();
+  return true;
+}
+
+bool DFSRndNumGenerator::load_trace(const std::string &path, size_t index,
+                                    unsigned &flags, uint64_t &rand_state) {
+  if (!SequenceTrace::read(path, index, flags, rand_state, *seq_))
+    return false;
+  use_debug_sequence_ = true;
+  return true;
+}
+
 /*
  *
  */
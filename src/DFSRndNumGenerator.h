@@ -30,6 +30,8 @@
 #ifndef DFS_RNDNUM_GENERATOR_H
 #define DFS_RNDNUM_GENERATOR_H
 
+#include <cstdint>
+#include <iosfwd>
 #include <string>
 #include <vector>
 
@@ -75,6 +77,28 @@ public:
 
   bool get_all_done(void) { return all_done_; }
 
+  // Start the search over, restricted to the programs of part `part' out of
+  // `parts'. A program belongs to the part its first choices hash to.
+  void restart(int parts, int part);
+
+  // Whether the program generated last belongs to the part being searched.
+  bool in_part(void);
+
+  // Write (read) the frontier of the search between two programs: the
+  // decision depth and the state of every level of the decision stack.
+  void save_state(std::ostream &out);
+
+  bool load_state(std::istream &in);
+
+  // The choices made so far by the program being generated.
+  Sequence &choices(void) { return *seq_; }
+
+  // Make the choices of record `index' of the trace `path' instead of
+  // searching, like --dfs-debug-sequence does. Return false if there is no
+  // such record.
+  bool load_trace(const std::string &path, size_t index, unsigned &flags,
+                  uint64_t &rand_state);
+
 private:
   // Forward declaration of nested class SearchState;
   class SearchState;
@@ -93,6 +117,10 @@ private:
 
   bool filter_invalid_nums(vector<int> *invalid_nums, int v);
 
+  int part_of(int pos, int v);
+
+  bool outside_part(int pos, int v);
+
   int random_choice(int bound, const Filter *f = nullptr,
                     const std::string *where = nullptr,
                     std::vector<int> *invalid_nums = nullptr);
@@ -103,7 +131,7 @@ private:
                  const char *log = nullptr);
 
   // ----------------------------------------------------------------------------------------
-  static DFSRndNumGenerator *impl_;
+  static thread_local DFSRndNumGenerator *impl_;
 
   // static std::string name_prefix;
 
@@ -122,6 +150,14 @@ private:
 
   bool use_debug_sequence_;
 
+  // The number of leading choices deciding the part of a program, the
+  // number of parts and the part being searched.
+  int part_depth_;
+
+  int parts_;
+
+  int part_;
+
   // Holds the vector representation of all DFS nodes.
   std::vector<SearchState *> states_;
 
@@ -38,6 +38,7 @@
 #include "Error.h"
 #include "Function.h"
 #include "FunctionInvocation.h"
+#include "RuntimePrelude.h"
 #include "Type.h"
 #include "VariableSelector.h"
 #include "platform.h"
@@ -57,18 +58,27 @@ static std::string dir_sep = "\\";
 
 using namespace std;
 
-DefaultOutputMgr *DefaultOutputMgr::instance_ = nullptr;
+static ostringstream *new_deferred() {
+  if (CGOptions::self_contained() || CGOptions::tailored_safe_math())
+    return new ostringstream;
+  return nullptr;
+}
+
+thread_local DefaultOutputMgr *DefaultOutputMgr::instance_ = nullptr;
 
-DefaultOutputMgr *DefaultOutputMgr::CreateInstance() {
+DefaultOutputMgr *DefaultOutputMgr::CreateInstance(std::ostream *out) {
   if (DefaultOutputMgr::instance_)
     return DefaultOutputMgr::instance_;
 
   std::string ofile_str = CGOptions::output_file();
-  if (!ofile_str.empty()) {
-    ofstream *ofile = new ofstream(ofile_str.c_str());
-    DefaultOutputMgr::instance_ = new DefaultOutputMgr(ofile);
+  if (out) {
+    DefaultOutputMgr::instance_ = new DefaultOutputMgr(out);
+  } else if (!ofile_str.empty()) {
+    DefaultOutputMgr::instance_ =
+        new DefaultOutputMgr(new FdOutput(ofile_str));
   } else {
-    DefaultOutputMgr::instance_ = new DefaultOutputMgr();
+    DefaultOutputMgr::instance_ =
+        new DefaultOutputMgr(new FdOutput(CGOptions::output_fd()));
   }
   // DefaultOutputMgr::instance_ = new DefaultOutputMgr();
   assert(DefaultOutputMgr::instance_);
@@ -76,12 +86,11 @@ DefaultOutputMgr *DefaultOutputMgr::CreateInstance() {
   return DefaultOutputMgr::instance_;
 }
 
-ofstream *DefaultOutputMgr::open_one_output_file(int num) {
+FdOutput *DefaultOutputMgr::open_one_output_file(int num) {
   std::ostringstream ss;
   ss << CGOptions::split_files_dir() << dir_sep << filename_prefix << num
      << ".c";
-  ofstream *ofile = new ofstream(ss.str().c_str());
-  return ofile;
+  return new FdOutput(ss.str());
 }
 
 void DefaultOutputMgr::init() {
@@ -91,7 +100,7 @@ void DefaultOutputMgr::init() {
     return;
 
   for (int i = 0; i < max_files; ++i) {
-    ofstream *out = open_one_output_file(i);
+    FdOutput *out = open_one_output_file(i);
     outs.push_back(out);
   }
 }
@@ -104,7 +113,7 @@ void DefaultOutputMgr::OutputGlobals() {
   std::ostringstream ss;
   ss << CGOptions::split_files_dir() << dir_sep << global_header << ".h";
 
-  ofstream ofile(ss.str().c_str());
+  FdOutput ofile(ss.str());
   ofile << "#ifndef RND_GLOBALS_H" << std::endl;
   ofile << "#define RND_GLOBALS_H" << std::endl;
   ofile << "#include \"safe_math.h\"" << std::endl;
@@ -119,7 +128,7 @@ void DefaultOutputMgr::OutputGlobals() {
 
 void DefaultOutputMgr::OutputAllHeaders() {
   for (unsigned i = 1; i < outs.size(); ++i) {
-    ofstream *out = outs[i];
+    FdOutput *out = outs[i];
     *out << "#include <stdint.h>" << std::endl;
 
     if (CGOptions::paranoid())
@@ -133,7 +142,7 @@ void DefaultOutputMgr::OutputAllHeaders() {
   *outs[0] << "#include \"" << global_header << ".h\"" << std::endl;
 
   for (auto j = outs.begin(); j != outs.end(); ++j) {
-    ofstream *out = (*j);
+    FdOutput *out = (*j);
     string prefix = "extern ";
     // OutputGlobalVariablesDecls(*out, prefix);
     OutputForwardDeclarations(*out);
@@ -192,16 +201,28 @@ void DefaultOutputMgr::Output() {
   if (!CGOptions::nomain())
     OutputMain(out);
   OutputTail(out);
+
+  if (!deferred_)
+    return;
+  if (CGOptions::self_contained())
+    RuntimePrelude::Expand(get_final_out(), deferred_->str());
+  else
+    RuntimePrelude::InsertSafeMath(get_final_out(), deferred_->str());
 }
 
 std::ostream &DefaultOutputMgr::get_main_out() {
+  if (deferred_)
+    return *deferred_;
+  return get_final_out();
+}
+
+std::ostream &DefaultOutputMgr::get_final_out() {
   if (is_split())
     return *(outs[0]);
-  else if (ofile_) {
+  else if (ofile_)
     return *ofile_;
-  } else {
-    return std::cout;
-  }
+  else
+    return *out_;
 }
 
 bool DefaultOutputMgr::is_split() { return (CGOptions::max_split_files() > 0); }
@@ -218,9 +239,13 @@ void DefaultOutputMgr::output_tab(ostream &out, int indent) {
 }
 
 //////////////////////////////////////////////////////////////////
-DefaultOutputMgr::DefaultOutputMgr(std::ofstream *ofile) : ofile_(ofile) {}
+DefaultOutputMgr::DefaultOutputMgr(FdOutput *ofile)
+    : ofile_(ofile), out_(nullptr),
+      deferred_(new_deferred()) {}
 
-DefaultOutputMgr::DefaultOutputMgr() : ofile_(nullptr) {}
+DefaultOutputMgr::DefaultOutputMgr(std::ostream *out)
+    : ofile_(nullptr), out_(out),
+      deferred_(new_deferred()) {}
 
 DefaultOutputMgr::~DefaultOutputMgr() {
   for (auto out = outs.begin(); out != outs.end(); ++out) {
@@ -231,4 +256,6 @@ DefaultOutputMgr::~DefaultOutputMgr() {
   if (ofile_)
     ofile_->close();
   delete ofile_;
+  delete deferred_;
+  DefaultOutputMgr::instance_ = nullptr;
 }
@@ -30,15 +30,16 @@
 #ifndef DEFAULT_OUTPUT_MGR_H
 #define DEFAULT_OUTPUT_MGR_H
 
+#include "FdOutput.h"
 #include "OutputMgr.h"
 #include "StdLibAliases.h"
-#include <fstream>
 #include <ostream>
+#include <sstream>
 #include <string>
 #include <vector>
 class DefaultOutputMgr : public OutputMgr {
 public:
-  static DefaultOutputMgr *CreateInstance();
+  static DefaultOutputMgr *CreateInstance(std::ostream *out = nullptr);
 
   virtual ~DefaultOutputMgr() override;
 
@@ -57,15 +58,17 @@ public:
   virtual void output_tab(ostream &out, int indent) override;
 
 private:
-  explicit DefaultOutputMgr(std::ofstream *ofile);
+  explicit DefaultOutputMgr(FdOutput *ofile);
 
-  DefaultOutputMgr();
+  explicit DefaultOutputMgr(std::ostream *out);
 
   virtual std::ostream &get_main_out() override;
 
+  std::ostream &get_final_out();
+
   bool is_split();
 
-  std::ofstream *open_one_output_file(int num);
+  FdOutput *open_one_output_file(int num);
 
   void init();
 
@@ -79,11 +82,19 @@ private:
 
   void RandomOutputFuncDefs();
 
-  static DefaultOutputMgr *instance_;
+  static thread_local DefaultOutputMgr *instance_;
+
+  std::vector<FdOutput *> outs;
+
+  // the --output file or --output-fd (stdout by default). Owned.
+  FdOutput *ofile_;
 
-  std::vector<std::ofstream *> outs;
+  // stream provided by the caller, e.g., in batch mode. Not owned.
+  std::ostream *out_;
 
-  std::ofstream *ofile_;
+  // with --self-contained or --tailored-safe-math, the program is held here
+  // until it is complete and the safe math wrappers it uses are known
+  std::ostringstream *deferred_;
 };
 
 #endif // DEFAULT_OUTPUT_MGR_H
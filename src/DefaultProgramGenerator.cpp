@@ -36,6 +36,8 @@
 #include "ExtensionMgr.h"
 #include "Finalization.h"
 #include "Function.h"
+#include "GenBudget.h"
+#include "Profiler.h"
 #include "RandomNumber.h"
 #include "SafeOpFlags.h"
 #include "Type.h"
@@ -43,8 +45,10 @@
 #include <sstream>
 
 DefaultProgramGenerator::DefaultProgramGenerator(int argc, char *argv[],
-                                                 unsigned long seed)
-    : argc_(argc), argv_(argv), seed_(seed), output_mgr_(nullptr) {}
+                                                 unsigned long seed,
+                                                 std::ostream *out)
+    : argc_(argc), argv_(argv), seed_(seed), out_(out),
+      output_mgr_(nullptr) {}
 
 DefaultProgramGenerator::~DefaultProgramGenerator() {
   Finalization::doFinalization();
@@ -53,7 +57,7 @@ DefaultProgramGenerator::~DefaultProgramGenerator() {
 
 void DefaultProgramGenerator::initialize() {
   RandomNumber::CreateInstance(RNDNUM_GENERATOR::rDefaultRndNumGenerator, seed_);
-  output_mgr_ = DefaultOutputMgr::CreateInstance();
+  output_mgr_ = DefaultOutputMgr::CreateInstance(out_);
   assert(output_mgr_);
 
   ExtensionMgr::CreateExtension();
@@ -65,11 +69,16 @@ std::string DefaultProgramGenerator::get_count_prefix(const std::string &) {
 }
 
 void DefaultProgramGenerator::goGenerator() {
+  ProfileScope scope(eProfPhase::eProgram);
+  GenBudget::start();
   output_mgr_->OutputHeader(argc_, argv_, seed_);
 
   GenerateAllTypes();
   GenerateFunctions();
-  output_mgr_->Output();
+  {
+    ProfileScope output_scope(eProfPhase::eOutput);
+    output_mgr_->Output();
+  }
   if (CGOptions::identify_wrappers()) {
     ofstream ofile;
     ofile.open("wrapper.h");
@@ -31,12 +31,14 @@
 #define DEFAULT_PROGRAM_GENERATOR_H
 
 #include "AbsProgramGenerator.h"
+#include <ostream>
 
 class OutputMgr;
 
 class DefaultProgramGenerator : public AbsProgramGenerator {
 public:
-  DefaultProgramGenerator(int argc, char *argv[], unsigned long seed);
+  DefaultProgramGenerator(int argc, char *argv[], unsigned long seed,
+                          std::ostream *out = nullptr);
 
   virtual ~DefaultProgramGenerator() override;
 
@@ -55,6 +57,8 @@ private:
 
   unsigned long seed_;
 
+  std::ostream *out_;
+
   OutputMgr *output_mgr_;
 };
 
@@ -39,10 +39,11 @@
 
 #include "CGOptions.h"
 #include "Filter.h"
+#include "Profiler.h"
 #include "Sequence.h"
 #include "SequenceFactory.h"
 
-DefaultRndNumGenerator *DefaultRndNumGenerator::impl_ = 0;
+thread_local DefaultRndNumGenerator *DefaultRndNumGenerator::impl_ = 0;
 
 /*
  *
@@ -58,6 +59,7 @@ DefaultRndNumGenerator::DefaultRndNumGenerator(const unsigned long,
  */
 DefaultRndNumGenerator::~DefaultRndNumGenerator() {
   SequenceFactory::destroy_sequences();
+  impl_ = 0;
 }
 
 /*
@@ -111,6 +113,7 @@ unsigned int DefaultRndNumGenerator::rnd_upto(const unsigned int n,
       // here. This will also overwrite the value added in the map.
       rand_depth_ = local_depth + 1;
       v = genrand() % n;
+      Profiler::incr(eProfCounter::eFilterRetries);
       /*out << g++ << ": " << v << "(" << n << ")" << endl;*/
     }
   }
@@ -166,7 +169,6 @@ std::string DefaultRndNumGenerator::RandomHexDigits(int num) {
   while (num--) {
     int x = genrand() % 16;
     str += hex1[x];
-    seq_->add_number(x, 16, rand_depth_);
     rand_depth_++;
   }
   return str;
@@ -181,7 +183,6 @@ std::string DefaultRndNumGenerator::RandomDigits(int num) {
   while (num--) {
     int x = genrand() % 10;
     str += dec1[x];
-    seq_->add_number(x, 10, rand_depth_);
     rand_depth_++;
   }
   return str;
@@ -71,7 +71,7 @@ private:
 
   void add_number(int v, int bound, int k);
 
-  static DefaultRndNumGenerator *impl_;
+  static thread_local DefaultRndNumGenerator *impl_;
 
   unsigned INT64 rand_depth_;
 
@@ -68,13 +68,34 @@ static bool non_empty_intersection(const vector<const Variable *> &va,
   return false;
 }
 
+/*
+ * id of the top-level variable that contains v, -1 if that has no id
+ */
+static int top_id(const Variable *v) {
+  const Variable *p = v->get_collective();
+  while (p->field_var_of) {
+    p = p->field_var_of->get_collective();
+  }
+  return p->effect_id;
+}
+
+static bool may_contain_top(const VariableBitSet &tops, bool has_untracked,
+                            const Variable *v) {
+  if (has_untracked) {
+    return true;
+  }
+  int id = top_id(v);
+  return id < 0 || tops.test(id);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 /*
  *
  */
 Effect::Effect(void)
-    : read_vars(0), write_vars(0), pure(true), side_effect_free(true) {
+    : read_vars(0), write_vars(0), has_untracked(false), pure(true),
+      side_effect_free(true) {
   // Nothing else to do.
 }
 
@@ -82,7 +103,9 @@ Effect::Effect(void)
  *
  */
 Effect::Effect(const Effect &e)
-    : read_vars(e.read_vars), write_vars(e.write_vars), pure(e.pure),
+    : read_vars(e.read_vars), write_vars(e.write_vars), read_ids(e.read_ids),
+      write_ids(e.write_ids), read_tops(e.read_tops), write_tops(e.write_tops),
+      has_untracked(e.has_untracked), pure(e.pure),
       side_effect_free(e.side_effect_free) {
   // Nothing else to do.
 }
@@ -104,6 +127,11 @@ Effect &Effect::operator=(const Effect &e) {
 
   read_vars = e.read_vars;
   write_vars = e.write_vars;
+  read_ids = e.read_ids;
+  write_ids = e.write_ids;
+  read_tops = e.read_tops;
+  write_tops = e.write_tops;
+  has_untracked = e.has_untracked;
   pure = e.pure;
   side_effect_free = e.side_effect_free;
 
@@ -113,9 +141,48 @@ Effect &Effect::operator=(const Effect &e) {
 /*
  *
  */
+void Effect::add_read(const Variable *v) {
+  read_vars.push_back(v);
+  int top = top_id(v);
+  if (v->effect_id < 0 || top < 0) {
+    has_untracked = true;
+  } else {
+    read_ids.set(v->effect_id);
+    read_tops.set(top);
+  }
+}
+
+void Effect::add_written(const Variable *v) {
+  write_vars.push_back(v);
+  int top = top_id(v);
+  if (v->effect_id < 0 || top < 0) {
+    has_untracked = true;
+  } else {
+    write_ids.set(v->effect_id);
+    write_tops.set(top);
+  }
+}
+
+void Effect::rebuild_bit_sets(void) {
+  vector<const Variable *> reads, writes;
+  reads.swap(read_vars);
+  writes.swap(write_vars);
+  read_ids.clear();
+  write_ids.clear();
+  read_tops.clear();
+  write_tops.clear();
+  has_untracked = false;
+  for (size_t i = 0; i < reads.size(); i++) {
+    add_read(reads[i]);
+  }
+  for (size_t i = 0; i < writes.size(); i++) {
+    add_written(writes[i]);
+  }
+}
+
 void Effect::read_var(const Variable *v) {
   if (!is_read(v)) {
-    read_vars.push_back(v);
+    add_read(v);
   }
   pure &= (v->is_const() && !v->is_volatile() && !v->is_access_once());
   side_effect_free &= (!v->is_volatile() && !v->is_access_once());
@@ -136,7 +203,7 @@ void Effect::access_deref_volatile(const Variable *v, int deref_level) {
 
 void Effect::write_var(const Variable *v) {
   if (!is_written(v)) {
-    write_vars.push_back(v);
+    add_written(v);
   }
   // pure = pure;
   // TODO: not quite correct below ---
@@ -168,14 +235,14 @@ void Effect::add_effect(const Effect &e, bool include_lhs_effects) {
   for (vector<const Variable *>::size_type i = 0; i < len; ++i) {
     // this->read_var(e.read_vars[i]);
     if (!is_read(e.read_vars[i])) {
-      this->read_vars.push_back(e.read_vars[i]);
+      add_read(e.read_vars[i]);
     }
   }
   len = e.write_vars.size();
   for (vector<const Variable *>::size_type i = 0; i < len; ++i) {
     // this->write_var(e.write_vars[i]);
     if (!is_written(e.write_vars[i])) {
-      this->write_vars.push_back(e.write_vars[i]);
+      add_written(e.write_vars[i]);
     }
   }
 
@@ -274,7 +341,9 @@ void Effect::add_external_effect(const Effect &e,
  *
  */
 bool Effect::is_read(const Variable *v) const {
-  if (std::find(read_vars.begin(), read_vars.end(), v) != read_vars.end()) {
+  if (v->effect_id >= 0 ? read_ids.test(v->effect_id)
+                        : std::find(read_vars.begin(), read_vars.end(), v) !=
+                              read_vars.end()) {
     return true;
   }
 
@@ -331,12 +400,10 @@ bool Effect::is_read(const string &vname) const {
  *
  */
 bool Effect::is_written(const Variable *v) const {
-  const vector<Variable *>::size_type len = write_vars.size();
-
-  for (vector<Variable *>::size_type i = 0; i < len; ++i) {
-    if (write_vars[i] == v) {
-      return true;
-    }
+  if (v->effect_id >= 0 ? write_ids.test(v->effect_id)
+                        : std::find(write_vars.begin(), write_vars.end(), v) !=
+                              write_vars.end()) {
+    return true;
   }
   // if we write a struct/union, presumingly all the fields are written too
   if (v->field_var_of) {
@@ -442,10 +509,16 @@ bool Effect::sibling_union_field_is_written(const Variable *v) const {
 }
 
 bool Effect::is_read_partially(const Variable *v) const {
+  if (!may_contain_top(read_tops, has_untracked, v)) {
+    return false;
+  }
   return is_read(v) || field_is_read(v) || sibling_union_field_is_read(v);
 }
 
 bool Effect::is_written_partially(const Variable *v) const {
+  if (!may_contain_top(write_tops, has_untracked, v)) {
+    return false;
+  }
   return is_written(v) || field_is_written(v) ||
          sibling_union_field_is_written(v);
 }
@@ -472,12 +545,18 @@ void Effect::consolidate(void) {
       len--;
     }
   }
+  rebuild_bit_sets();
 }
 
 /*
  *
  */
 bool Effect::has_race_with(const Effect &e) const {
+  if (!has_untracked && !e.has_untracked && !read_tops.intersects(e.write_tops) &&
+      !write_tops.intersects(e.read_tops) &&
+      !write_tops.intersects(e.write_tops)) {
+    return false;
+  }
   return (non_empty_intersection(this->read_vars, e.write_vars) ||
           non_empty_intersection(this->write_vars, e.read_vars) ||
           non_empty_intersection(this->write_vars, e.write_vars));
@@ -496,6 +575,11 @@ bool Effect::is_empty(void) const {
 void Effect::clear(void) {
   read_vars.clear();
   write_vars.clear();
+  read_ids.clear();
+  write_ids.clear();
+  read_tops.clear();
+  write_tops.clear();
+  has_untracked = false;
   pure = side_effect_free = true;
 }
 
@@ -32,6 +32,7 @@
 
 ///////////////////////////////////////////////////////////////////////////////
 
+#include "VariableBitSet.h"
 #include <ostream>
 #include <vector>
 
@@ -99,10 +100,25 @@ public:
   void update_purity(void);
 
 private:
+  void add_read(const Variable *v);
+  void add_written(const Variable *v);
+  void rebuild_bit_sets(void);
+
   std::vector<const Variable *> read_vars;
   std::vector<const Variable *> write_vars;
   std::vector<const Variable *> lhs_write_vars;
 
+  // membership of read_vars/write_vars, and of the top-level variables
+  // containing them. two variables can only overlap (be the same, one a
+  // field of the other, or fields of the same union) if their top-level
+  // containers are the same, so the latter rule out conflicts cheaply
+  VariableBitSet read_ids;
+  VariableBitSet write_ids;
+  VariableBitSet read_tops;
+  VariableBitSet write_tops;
+  // some variables have no id, the bit sets can't vouch for them
+  bool has_untracked;
+
   bool pure;
   bool side_effect_free;
 
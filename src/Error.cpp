@@ -31,7 +31,7 @@
 
 #include "Error.h"
 
-int Error::r_error_ = SUCCESS;
+thread_local int Error::r_error_ = SUCCESS;
 
 Error::Error() {}
 
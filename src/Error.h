@@ -88,7 +88,7 @@ public:
 private:
   Error();
   ~Error();
-  static int r_error_;
+  static thread_local int r_error_;
 
   Error(const Error &) = delete;
   Error &operator=(const Error &) = delete;
@@ -60,10 +60,10 @@
 #include "VectorFilter.h"
 #include "random.h"
 
-int eid = 0;
+thread_local int eid = 0;
 
-DistributionTable Expression::exprTable_;
-DistributionTable Expression::paramTable_;
+thread_local DistributionTable Expression::exprTable_;
+thread_local DistributionTable Expression::paramTable_;
 
 void Expression::InitExprProbabilityTable() {
   exprTable_.add_entry((int)eTermType::eFunction, 70);
@@ -95,6 +95,16 @@ void Expression::InitProbabilityTables() {
   Expression::InitParamProbabilityTable();
 }
 
+/*
+ * Reset expression ids and the tables built from the probabilities, which
+ * are re-initialized for each generated program
+ */
+void Expression::doFinalization() {
+  eid = 0;
+  exprTable_.clear();
+  paramTable_.clear();
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 /*
@@ -149,6 +159,7 @@ Expression *Expression::make_random(CGContext &cg_context, const Type *type,
       type = cg_context.get_effect_context().is_side_effect_free()
                  ? Type::choose_random_nonvoid()
                  : Type::choose_random_nonvoid_nonvolatile();
+      ERROR_GUARD(nullptr);
     } while (type->eType == eTypeDesc::eStruct && tt == eTermType::eConstant);
   }
   assert(!(no_func && tt == eTermType::eFunction));
@@ -202,6 +213,7 @@ Expression *Expression::make_random(CGContext &cg_context, const Type *type,
   default:
     break;
   }
+  ERROR_GUARD(nullptr);
 #if 0
 	if (!cg_context.get_effect_context().is_side_effect_free()) {
 		assert(e->effect.is_side_effect_free());
@@ -214,7 +226,6 @@ Expression *Expression::make_random(CGContext &cg_context, const Type *type,
        e->get_invoke()->invoke_type == eInvocationType::eFuncCall)) {
     cg_context.expr_depth++;
   }
-  ERROR_GUARD(nullptr);
   return e;
 }
 
@@ -290,7 +301,6 @@ Expression *Expression::make_random_param(CGContext &cg_context,
        e->get_invoke()->invoke_type == eInvocationType::eFuncCall)) {
     cg_context.expr_depth++;
   }
-  ERROR_GUARD(nullptr);
   return e;
 }
 
@@ -43,6 +43,7 @@
 
 #include "CGContext.h"
 #include "CVQualifiers.h"
+#include "NodePool.h"
 #include "ProbabilityTable.h"
 #include "StdLibAliases.h"
 #include <ostream>
@@ -103,12 +104,19 @@ public:
 
   static void InitProbabilityTables();
 
+  static void doFinalization();
+
   Expression(eTermType e);
 
   Expression(const Expression &expr);
 
   virtual ~Expression(void);
 
+  static void *operator new(size_t size) { return NodePool::allocate(size); }
+  static void operator delete(void *p, size_t size) {
+    NodePool::deallocate(p, size);
+  }
+
   virtual Expression *clone() const = 0;
 
   virtual const Type &get_type(void) const = 0;
@@ -171,8 +179,8 @@ private:
   static void InitExprProbabilityTable();
   static void InitParamProbabilityTable();
 
-  static DistributionTable exprTable_;
-  static DistributionTable paramTable_;
+  static thread_local DistributionTable exprTable_;
+  static thread_local DistributionTable paramTable_;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
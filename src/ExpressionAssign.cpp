@@ -34,6 +34,7 @@
 #include "CGContext.h"
 #include "CGOptions.h"
 #include "Common.h"
+#include "Error.h"
 #include "ExpressionAssign.h"
 #include "FactMgr.h"
 #include "Function.h"
@@ -52,13 +53,16 @@ Expression *ExpressionAssign::make_random(CGContext &cg_context,
   if (qfer == nullptr) {
     CVQualifiers qf =
         CVQualifiers::random_qualifiers(type, Effect::Access::WRITE, cg_context, true);
+    ERROR_GUARD(nullptr);
     StatementAssign *sa = StatementAssign::make_random(cg_context, type, &qf);
+    ERROR_GUARD(nullptr);
     FactMgr *fm = get_fact_mgr(&cg_context);
     FactMgr::update_fact_for_assign(sa, fm->global_facts);
     ExpressionAssign *ea = new ExpressionAssign(sa);
     return ea;
   }
   StatementAssign *sa = StatementAssign::make_random(cg_context, type, qfer);
+  ERROR_GUARD(nullptr);
   FactMgr *fm = get_fact_mgr(&cg_context);
   FactMgr::update_fact_for_assign(sa, fm->global_facts);
   ExpressionAssign *ea = new ExpressionAssign(sa);
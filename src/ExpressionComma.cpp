@@ -34,6 +34,7 @@
 #include "CGContext.h"
 #include "CGOptions.h"
 #include "Common.h"
+#include "Error.h"
 #include "Type.h"
 #include "util.h"
 
@@ -57,8 +58,10 @@ ExpressionComma *ExpressionComma::make_random(CGContext &cg_context,
                                               const CVQualifiers *qfer) {
   Expression *lhs =
       Expression::make_random(cg_context, nullptr, nullptr, false, true);
+  ERROR_GUARD(nullptr);
   Expression *rhs =
       Expression::make_random(cg_context, type, qfer, false, false);
+  ERROR_GUARD_AND_DEL1(nullptr, lhs);
   // typecast, if needed.
   if (CGOptions::lang_cpp())
     cast_if_needed(rhs);
@@ -43,7 +43,7 @@
 
 using namespace std;
 
-AbsExtension *ExtensionMgr::extension_ = nullptr;
+thread_local AbsExtension *ExtensionMgr::extension_ = nullptr;
 
 void ExtensionMgr::CreateExtension() {
   int params_size = CGOptions::func1_max_params();
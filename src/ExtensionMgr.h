@@ -62,7 +62,7 @@ public:
                                        FunctionInvocation *invoke);
 
 private:
-  static AbsExtension *extension_;
+  static thread_local AbsExtension *extension_;
 };
 
 #endif // EXTENSION_MGR_H
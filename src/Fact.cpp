@@ -37,9 +37,10 @@
 #include "StatementReturn.h"
 #include "Variable.h"
 #include <cassert>
+#include <cstdint>
 
 using namespace std;
-std::vector<Fact *> Fact::facts_;
+thread_local std::vector<Fact *> Fact::facts_;
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -107,6 +108,21 @@ vector<const Fact *> Fact::abstract_fact_for_var_init(const Variable *v) {
   return facts;
 }
 
+size_t Fact::hash_ptr(const void *p) {
+  uint64_t x = reinterpret_cast<uintptr_t>(p);
+  x ^= x >> 33;
+  x *= 0xff51afd7ed558ccdULL;
+  x ^= x >> 33;
+  return static_cast<size_t>(x);
+}
+
+void Fact::discard(Fact *f) {
+  if (!facts_.empty() && facts_.back() == f) {
+    facts_.pop_back();
+    delete f;
+  }
+}
+
 void Fact::doFinalization() {
   for (auto i = facts_.begin(); i != facts_.end(); ++i) {
     delete (*i);
@@ -155,7 +171,7 @@ bool merge_fact(FactVec &facts, const Fact *new_fact) {
       if (!f->imply(*new_fact)) {
         Fact *copy_fact = new_fact->clone();
         copy_fact->join(*f);
-        facts[i] = copy_fact;
+        facts[i] = copy_fact->intern();
         changed = true;
         // TODO: release the memory for f???
       } else {
@@ -236,6 +252,21 @@ void combine_facts(vector<Fact *> &facts1, const FactVec &facts2) {
 
 bool same_facts(const FactVec &facts1, const FactVec &facts2) {
   if (facts1.size() == facts2.size()) {
+    // facts are interned, so an unchanged env is usually the very same
+    // sequence of fact objects
+    if (facts1 == facts2) {
+      return true;
+    }
+    // each env holds at most one fact per variable, so the order-insensitive
+    // sum of fingerprints must match for the envs to be the same
+    size_t h1 = 0, h2 = 0;
+    for (size_t i = 0; i < facts1.size(); i++) {
+      h1 += facts1[i]->fingerprint();
+      h2 += facts2[i]->fingerprint();
+    }
+    if (h1 != h2) {
+      return false;
+    }
     for (size_t i = 0; i < facts1.size(); i++) {
       if (find_fact(facts2, facts1[i]) == -1) {
         return false;
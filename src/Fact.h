@@ -32,6 +32,7 @@
 
 ///////////////////////////////////////////////////////////////////////////////
 
+#include "NodePool.h"
 #include "StdLibAliases.h"
 #include <ostream>
 #include <vector>
@@ -62,6 +63,11 @@ public:
 
   virtual ~Fact(void);
 
+  static void *operator new(size_t size) { return NodePool::allocate(size); }
+  static void operator delete(void *p, size_t size) {
+    NodePool::deallocate(p, size);
+  }
+
   virtual Fact *clone(void) const = 0;
 
   virtual int join(const Fact & /*fact*/) { return 0; };
@@ -84,6 +90,14 @@ public:
 
   virtual bool equal(const Fact &fact) const { return this == &fact; };
 
+  /// Hash of the fact that agrees with equal(): equal facts always have the
+  /// same fingerprint, so differing fingerprints rule out equality cheaply.
+  virtual size_t fingerprint(void) const { return hash_ptr(this); }
+
+  /// Return the shared instance equal (element by element) to this fact,
+  /// registering this fact as that instance if there is none yet.
+  virtual const Fact *intern(void) { return this; }
+
   virtual void Output(std::ostream &out) const = 0;
 
   virtual void OutputAssertion(std::ostream &out,
@@ -112,8 +126,13 @@ public:
   eFactCategory eCat;
 
 protected:
+  static size_t hash_ptr(const void *p);
+
+  // drop a freshly cloned fact that turned out to duplicate an interned one
+  static void discard(Fact *f);
+
   // keep track all created facts. used for releasing memory in doFinalization
-  static std::vector<Fact *> facts_;
+  static thread_local std::vector<Fact *> facts_;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -35,14 +35,17 @@
 
 #include "FactMgr.h"
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 #include <map>
 #include <sstream>
 #include <vector>
 
+#include "ArrayVariable.h"
 #include "Block.h"
 #include "CFGEdge.h"
+#include "CGContext.h"
 #include "CGOptions.h"
 #include "Expression.h"
 #include "ExpressionVariable.h"
@@ -64,7 +67,7 @@
 
 using namespace std;
 
-std::vector<Fact *> FactMgr::meta_facts;
+thread_local std::vector<Fact *> FactMgr::meta_facts;
 
 void FactMgr::add_new_var_fact_and_update_inout_maps(const Block *blk,
                                                      const Variable *var) {
@@ -84,21 +87,21 @@ void FactMgr::add_new_var_fact_and_update_inout_maps(const Block *blk,
         global_facts.push_back(f);
       }
 
-      for (auto iter = map_facts_in.begin(); iter != map_facts_in.end();
-           ++iter) {
-        const Statement *stm = iter->first;
-        if (stm && (stm->in_block(blk) || blk == nullptr)) {
-          iter->second.push_back(f);
+      for (size_t j = 0; j < map_facts_in.size(); j++) {
+        const Statement *stm = slot_stms[j];
+        if (map_facts_in.has_slot(j) &&
+            (stm->in_block(blk) || blk == nullptr)) {
+          map_facts_in.at_slot(j).push_back(f);
         }
       }
-      for (auto iter = map_facts_out.begin(); iter != map_facts_out.end();
-           ++iter) {
-        const Statement *stm = iter->first;
-        assert(stm);
+      for (size_t j = 0; j < map_facts_out.size(); j++) {
+        if (!map_facts_out.has_slot(j)) {
+          continue;
+        }
         if (blk) {
-          add_fact_out(stm, f);
+          add_fact_out(slot_stms[j], f);
         } else {
-          iter->second.push_back(f);
+          map_facts_out.at_slot(j).push_back(f);
         }
       }
     }
@@ -209,42 +212,222 @@ void FactMgr::setup_in_out_maps(bool first_time) {
   if (first_time) {
     // first time revisit, create map_facts_in_final and map_facts_out_final
     // with cloned facts
-    for (auto iter = map_facts_in.begin(); iter != map_facts_in.end(); ++iter) {
-      const Statement *stm = iter->first;
-      const vector<const Fact *> &facts1 = iter->second;
-      map_facts_in_final[stm] = copy_facts(facts1);
+    for (size_t i = 0; i < map_facts_in.size(); i++) {
+      if (map_facts_in.has_slot(i)) {
+        map_facts_in_final[slot_stms[i]] = copy_facts(map_facts_in.at_slot(i));
+      }
     }
-    for (auto iter = map_facts_out.begin(); iter != map_facts_out.end();
-         ++iter) {
-      const Statement *stm = iter->first;
-      const vector<const Fact *> &facts1 = iter->second;
-      map_facts_out_final[stm] = copy_facts(facts1);
+    for (size_t i = 0; i < map_facts_out.size(); i++) {
+      if (map_facts_out.has_slot(i)) {
+        map_facts_out_final[slot_stms[i]] =
+            copy_facts(map_facts_out.at_slot(i));
+      }
     }
   } else {
     // not the 1st time revisit
     // combine facts_in and facts_out from this invocation with facts from
     // previous invocations
-    for (auto iter = map_facts_in_final.begin();
-         iter != map_facts_in_final.end();
-         ++iter) {
-      const Statement *stm = iter->first;
-      vector<Fact *> &facts1 = iter->second;
-      const FactVec &facts2 = map_facts_in[stm];
-      combine_facts(facts1, facts2);
-    }
-    for (auto iter = map_facts_out_final.begin();
-         iter != map_facts_out_final.end();
-         ++iter) {
-      const Statement *stm = iter->first;
-      vector<Fact *> &facts1 = iter->second;
-      const FactVec &facts2 = map_facts_out[stm];
-      combine_facts(facts1, facts2);
+    for (size_t i = 0; i < map_facts_in_final.size(); i++) {
+      if (map_facts_in_final.has_slot(i)) {
+        const FactVec &facts2 = map_facts_in[slot_stms[i]];
+        combine_facts(map_facts_in_final.at_slot(i), facts2);
+      }
+    }
+    for (size_t i = 0; i < map_facts_out_final.size(); i++) {
+      if (map_facts_out_final.has_slot(i)) {
+        const FactVec &facts2 = map_facts_out[slot_stms[i]];
+        combine_facts(map_facts_out_final.at_slot(i), facts2);
+      }
     }
   }
   // JYTODO: beef up the sanity check
   // sanity_check_map();
 }
 
+// keep the summaries of this many distinct calling contexts per function
+static const size_t max_call_summaries = 16;
+
+static size_t call_summary_key(const FactVec &facts) {
+  size_t key = 0;
+  for (size_t i = 0; i < facts.size(); i++) {
+    key += facts[i]->fingerprint();
+  }
+  return key;
+}
+
+// the named variable a fact is about, or null for facts other than points-to
+static const Variable *fact_root(const Fact *f) {
+  if (f->eCat != eFactCategory::ePointTo)
+    return nullptr;
+  return f->get_var()->get_named_var();
+}
+
+static bool is_root_in(const Fact *f, const vector<const Variable *> &roots) {
+  const Variable *root = fact_root(f);
+  return !root || std::find(roots.begin(), roots.end(), root) != roots.end();
+}
+
+static bool add_root(vector<const Variable *> &roots, const Variable *v) {
+  if (std::find(roots.begin(), roots.end(), v) != roots.end())
+    return false;
+  roots.push_back(v);
+  return true;
+}
+
+static int find_related_fact_pos(const FactVec &facts, const Fact *f) {
+  for (size_t i = 0; i < facts.size(); i++) {
+    if (facts[i]->is_related(*f))
+      return i;
+  }
+  return -1;
+}
+
+// the variables whose address initializes a local of f or of its callees
+static void add_init_roots(const Function *f, vector<const Variable *> &roots,
+                           vector<const Function *> &seen) {
+  if (std::find(seen.begin(), seen.end(), f) != seen.end())
+    return;
+  seen.push_back(f);
+  for (size_t i = 0; i < f->blocks.size(); i++) {
+    const vector<Variable *> &vars = f->blocks[i]->local_vars;
+    for (size_t j = 0; j < vars.size(); j++) {
+      vector<const Expression *> inits(1, vars[j]->init);
+      if (vars[j]->isArray) {
+        const ArrayVariable *av = dynamic_cast<const ArrayVariable *>(vars[j]);
+        inits.insert(inits.end(), av->get_init_values().begin(),
+                     av->get_init_values().end());
+      }
+      for (size_t k = 0; k < inits.size(); k++) {
+        const ExpressionVariable *ev =
+            dynamic_cast<const ExpressionVariable *>(inits[k]);
+        if (ev)
+          add_root(roots, ev->get_var()->get_named_var());
+      }
+    }
+  }
+  vector<const FunctionInvocationUser *> calls;
+  if (f->body)
+    f->body->get_called_funcs(calls);
+  for (size_t i = 0; i < calls.size(); i++) {
+    add_init_roots(calls[i]->get_func(), roots, seen);
+  }
+}
+
+/*
+ * The body can only dereference or assign the pointers it (or a callee)
+ * references, copy the variables it reads or writes by name (e.g., structs
+ * with pointer fields), use its parameters and return value, take the address
+ * of variables to initialize locals, and reach whatever is reachable from
+ * those through the points-to facts. The facts of all other variables pass
+ * through the body unchanged and do not affect its analysis.
+ */
+void FactMgr::find_relevant_facts(const FactVec &inputs, FactVec &relevant,
+                                  vector<const Variable *> &roots) const {
+  roots.clear();
+  const vector<const Variable *> &ptrs = func->get_referenced_ptrs();
+  for (size_t i = 0; i < ptrs.size(); i++) {
+    add_root(roots, ptrs[i]->get_named_var());
+  }
+  const Effect &effect = func->get_feffect();
+  for (size_t i = 0; i < effect.get_read_vars().size(); i++) {
+    add_root(roots, effect.get_read_vars()[i]->get_named_var());
+  }
+  for (size_t i = 0; i < effect.get_write_vars().size(); i++) {
+    add_root(roots, effect.get_write_vars()[i]->get_named_var());
+  }
+  for (size_t i = 0; i < func->param.size(); i++) {
+    add_root(roots, func->param[i]);
+  }
+  add_root(roots, func->rv);
+  vector<const Function *> seen;
+  add_init_roots(func, roots, seen);
+  // reach pointees until there are no new ones
+  for (bool changed = true; changed;) {
+    changed = false;
+    for (size_t i = 0; i < inputs.size(); i++) {
+      if (!fact_root(inputs[i]) || !is_root_in(inputs[i], roots))
+        continue;
+      const FactPointTo *fp = dynamic_cast<const FactPointTo *>(inputs[i]);
+      const vector<const Variable *> &pointees = fp->get_point_to_vars();
+      for (size_t j = 0; j < pointees.size(); j++) {
+        if (!FactPointTo::is_special_ptr(pointees[j]) &&
+            add_root(roots, pointees[j]->get_named_var())) {
+          changed = true;
+        }
+      }
+    }
+  }
+  relevant.clear();
+  for (size_t i = 0; i < inputs.size(); i++) {
+    if (is_root_in(inputs[i], roots))
+      relevant.push_back(inputs[i]);
+  }
+}
+
+const CallSummary *FactMgr::find_call_summary(
+    const FactVec &relevant, const CGContext &cg_context) const {
+  const size_t key = call_summary_key(relevant);
+  const bool side_effect_free =
+      cg_context.get_effect_context().is_side_effect_free();
+  for (size_t i = 0; i < call_summaries.size(); i++) {
+    const CallSummary &summary = call_summaries[i];
+    if (summary.key == key && summary.flags == cg_context.flags &&
+        summary.side_effect_free == side_effect_free &&
+        same_facts(summary.inputs, relevant)) {
+      return &summary;
+    }
+  }
+  return nullptr;
+}
+
+void FactMgr::add_call_summary(const FactVec &relevant,
+                               const CGContext &cg_context,
+                               const vector<const Variable *> &roots,
+                               const FactVec &outputs,
+                               const FactVec &return_facts,
+                               const Effect &effect) {
+  if (call_summaries.size() == max_call_summaries) {
+    call_summaries.pop_back();
+  }
+  call_summaries.push_front(CallSummary{
+      call_summary_key(relevant), relevant, cg_context.flags,
+      cg_context.get_effect_context().is_side_effect_free(), roots, FactVec(),
+      FactVec(), effect});
+  CallSummary &summary = call_summaries.front();
+  for (size_t i = 0; i < outputs.size(); i++) {
+    if (is_root_in(outputs[i], roots))
+      summary.outputs.push_back(outputs[i]);
+  }
+  for (size_t i = 0; i < return_facts.size(); i++) {
+    if (is_root_in(return_facts[i], roots))
+      summary.return_facts.push_back(return_facts[i]);
+  }
+}
+
+/*
+ * turn the inputs of a call into the facts at the end of the body, the way
+ * the analysis would: facts are updated in place, new ones appended
+ */
+void FactMgr::apply_call_summary(const CallSummary &summary, FactVec &inputs) {
+  const FactVec &outputs = summary.outputs;
+  for (size_t i = 0; i < inputs.size();) {
+    if (is_root_in(inputs[i], summary.roots) &&
+        find_related_fact_pos(outputs, inputs[i]) == -1) {
+      inputs.erase(inputs.begin() + i);
+    } else {
+      i++;
+    }
+  }
+  for (size_t i = 0; i < outputs.size(); i++) {
+    const int pos = find_related_fact_pos(inputs, outputs[i]);
+    if (pos == -1) {
+      inputs.push_back(outputs[i]);
+    } else {
+      inputs[pos] = outputs[i];
+    }
+  }
+}
+
 void FactMgr::set_fact_in(const Statement *s, const FactVec &facts) {
   map_facts_in[s] = facts;
 }
@@ -460,7 +643,10 @@ void FactMgr::update_facts_for_dest(const FactVec &facts_in, FactVec &facts_out,
 /*
  *
  */
-FactMgr::FactMgr(const Function *f) : func(f) {}
+FactMgr::FactMgr(const Function *f)
+    : map_facts_in(this), map_facts_out(this), map_facts_in_final(this),
+      map_facts_out_final(this), map_stm_effect(this), map_accum_effect(this),
+      map_visited(this), func(f) {}
 
 /*
  *
@@ -477,11 +663,12 @@ void FactMgr::add_interested_facts(int interests) {
   if (interests & static_cast<int>(eFactCategory::ePointTo)) {
     // meta_facts.push_back(new FactPointTo(0));
     // meta_facts.push_back(FactPointTo::make_fact(0));
-    FactPointTo *fp = FactPointTo::make_fact(0);
+    // meta facts are not shared, transfer functions are invoked on them
+    Fact *fp = FactPointTo::make_fact(0)->clone();
     meta_facts.push_back(fp);
   }
   if (interests & static_cast<int>(eFactCategory::eUnionWrite)) {
-    FactUnion *fu = FactUnion::make_fact(0, 0);
+    Fact *fu = FactUnion::make_fact(0, 0)->clone();
     meta_facts.push_back(fu);
   }
 }
@@ -508,43 +695,62 @@ void FactMgr::makeup_new_var_facts(vector<const Fact *> &old_facts,
 }
 
 void FactMgr::clear_map_visited(void) {
-  for (auto iter = map_visited.begin(); iter != map_visited.end(); ++iter) {
-    iter->second = false;
+  for (size_t i = 0; i < map_visited.size(); i++) {
+    map_visited.at_slot(i) = false;
   }
 }
 
-void FactMgr::backup_stm_fact_maps(const Statement *stm,
-                                   map<const Statement *, FactVec> &facts_in,
-                                   map<const Statement *, FactVec> &facts_out) {
-  vector<const Block *> blks;
-  stm->get_blocks(blks);
-  for (size_t i = 0; i < blks.size(); i++) {
-    const Block *b = blks[i];
-    facts_in[b] = map_facts_in[b];
-    facts_out[b] = map_facts_out[b];
-    for (size_t j = 0; j < b->stms.size(); j++) {
-      backup_stm_fact_maps(b->stms[j], facts_in, facts_out);
-    }
+size_t FactMgr::get_slot(const Statement *stm) const {
+  assert(stm);
+  if (stm->fact_slot < 0) {
+    stm->fact_slot = slot_stms.size();
+    slot_stms.push_back(stm);
+  }
+  // a statement only ever has entries in the FactMgr of its own function
+  assert(slot_stms[stm->fact_slot] == stm);
+  return stm->fact_slot;
+}
+
+int FactMgr::find_slot(const Statement *stm) const {
+  if (stm->fact_slot < 0 || (size_t)stm->fact_slot >= slot_stms.size() ||
+      slot_stms[stm->fact_slot] != stm) {
+    return -1;
   }
-  facts_in[stm] = map_facts_in[stm];
-  facts_out[stm] = map_facts_out[stm];
+  return stm->fact_slot;
+}
+
+/*
+ * the tables are flat per function, so backing up is a bulk copy of them
+ */
+void FactMgr::backup_stm_fact_maps(StatementTable<FactVec> &facts_in,
+                                   StatementTable<FactVec> &facts_out) const {
+  facts_in = map_facts_in;
+  facts_out = map_facts_out;
 }
 
-void FactMgr::restore_stm_fact_maps(
-    const Statement *stm, map<const Statement *, FactVec> &facts_in,
-    map<const Statement *, FactVec> &facts_out) {
+/*
+ * restore input/output env of this statement and all statements included
+ */
+void FactMgr::restore_stm_fact_maps(const Statement *stm,
+                                    const StatementTable<FactVec> &facts_in,
+                                    const StatementTable<FactVec> &facts_out) {
+  FactVec empty;
   vector<const Block *> blks;
   stm->get_blocks(blks);
   for (size_t i = 0; i < blks.size(); i++) {
     const Block *b = blks[i];
-    map_facts_in[b] = facts_in[b];
-    map_facts_out[b] = facts_out[b];
+    const FactVec *in = facts_in.find(b);
+    const FactVec *out = facts_out.find(b);
+    map_facts_in[b] = in ? *in : empty;
+    map_facts_out[b] = out ? *out : empty;
     for (size_t j = 0; j < b->stms.size(); j++) {
       restore_stm_fact_maps(b->stms[j], facts_in, facts_out);
     }
   }
-  map_facts_in[stm] = facts_in[stm];
-  map_facts_out[stm] = facts_out[stm];
+  const FactVec *in = facts_in.find(stm);
+  const FactVec *out = facts_out.find(stm);
+  map_facts_in[stm] = in ? *in : empty;
+  map_facts_out[stm] = out ? *out : empty;
 }
 
 /*
@@ -701,9 +907,11 @@ void FactMgr::find_dangling_global_ptrs(Function *f) {
 }
 
 void FactMgr::sanity_check_map() const {
-  for (auto iter = map_facts_in.begin(); iter != map_facts_in.end(); ++iter) {
-    const Statement *stm = iter->first;
-    const vector<const Fact *> &facts = iter->second;
+  for (size_t j = 0; j < map_facts_in.size(); j++) {
+    if (!map_facts_in.has_slot(j))
+      continue;
+    const Statement *stm = slot_stms[j];
+    const vector<const Fact *> &facts = map_facts_in.at_slot(j);
     for (size_t i = 0; i < facts.size(); i++) {
       const Variable *v = facts[i]->get_var();
       if (!v->is_visible(stm->parent)) {
@@ -717,9 +925,11 @@ void FactMgr::sanity_check_map() const {
     }
   }
 
-  for (auto iter = map_facts_out.begin(); iter != map_facts_out.end(); ++iter) {
-    const Statement *stm = iter->first;
-    const vector<const Fact *> &facts = iter->second;
+  for (size_t j = 0; j < map_facts_out.size(); j++) {
+    if (!map_facts_out.has_slot(j))
+      continue;
+    const Statement *stm = slot_stms[j];
+    const vector<const Fact *> &facts = map_facts_out.at_slot(j);
     for (size_t i = 0; i < facts.size(); i++) {
       const Variable *v = facts[i]->get_var();
       if (!v->is_visible(stm->parent) && !func->rv->match(v)) {
@@ -736,6 +946,8 @@ const vector<const Fact *> &FactMgr::get_program_end_facts(void) {
 
 void FactMgr::doFinalization() {
   Fact::doFinalization();
+  FactPointTo::doFinalization();
+  FactUnion::doFinalization();
   meta_facts.clear();
 }
 
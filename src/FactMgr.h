@@ -50,17 +50,69 @@ class FunctionInvocationUser;
 class CGContext;
 class Lhs;
 class CFGEdge;
+class FactMgr;
 
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "Effect.h"
 #include "Fact.h"
 #include "StdLibAliases.h"
-#include <map>
+#include <deque>
 #include <ostream>
 #include <vector>
 ///////////////////////////////////////////////////////////////////////////////
 
+/*
+ * per-statement table of one function, indexed by the dense slot the
+ * function's FactMgr hands out to each of its statements. storage is chunked
+ * so references returned by operator[] survive the table growing, which the
+ * callers rely on (e.g. "t[a].add_effect(t[b])")
+ */
+template <typename T> class StatementTable {
+public:
+  explicit StatementTable(const FactMgr *fm) : fm_(fm) {}
+
+  // like std::map::operator[], creates an entry if there was none
+  T &operator[](const Statement *s);
+
+  // like std::map::find, nullptr if there is no entry for the statement
+  const T *find(const Statement *s) const;
+
+  // number of slots with storage, slots without an entry hold default values
+  size_t size(void) const { return values_.size(); }
+  bool has_slot(size_t i) const { return present_[i]; }
+  T &at_slot(size_t i) { return values_[i]; }
+  const T &at_slot(size_t i) const { return values_[i]; }
+
+private:
+  const FactMgr *fm_;
+  std::deque<T> values_;
+  // unlike a deque, allocates nothing until the first entry
+  std::vector<bool> present_;
+};
+
+/*
+ * the result of analyzing a function body for the facts of one call, after
+ * the caller-to-callee handover (see FunctionInvocationUser::revisit). Only
+ * the facts the body can read or change are kept: those of the variables in
+ * roots (see FactMgr::find_relevant_facts)
+ */
+struct CallSummary {
+  // sum of the fingerprints of inputs
+  size_t key;
+  FactVec inputs;
+  // the parts of the calling context the analysis checks besides the effects
+  // (see CGContext::check_write_var and CGContext::check_deref_volatile)
+  unsigned int flags;
+  bool side_effect_free;
+  std::vector<const Variable *> roots;
+  // facts at the end of the body, and at its return statements
+  FactVec outputs;
+  FactVec return_facts;
+  // the effect the visit accumulated
+  Effect effect;
+};
+
 class FactMgr {
 public:
   FactMgr(const Function *f);
@@ -89,6 +141,20 @@ public:
 
   void setup_in_out_maps(bool first_time);
 
+  // the facts of inputs the body of the (built) function can read or change,
+  // and the named variables they are about
+  void find_relevant_facts(const FactVec &inputs, FactVec &relevant,
+                           std::vector<const Variable *> &roots) const;
+
+  // the analysis of an earlier call with the same relevant facts, if any
+  const CallSummary *find_call_summary(const FactVec &relevant,
+                                       const CGContext &cg_context) const;
+  void add_call_summary(const FactVec &relevant, const CGContext &cg_context,
+                        const std::vector<const Variable *> &roots,
+                        const FactVec &outputs, const FactVec &return_facts,
+                        const Effect &effect);
+  static void apply_call_summary(const CallSummary &summary, FactVec &inputs);
+
   void set_fact_in(const Statement *s, const FactVec &facts);
   void set_fact_out(const Statement *s, const FactVec &facts);
   void add_fact_out(const Statement *stm, const Fact *fact);
@@ -97,12 +163,11 @@ public:
                        bool post_stm_edge, bool back_link);
 
   void clear_map_visited(void);
-  void backup_stm_fact_maps(const Statement *stm,
-                            map<const Statement *, FactVec> &facts_in,
-                            map<const Statement *, FactVec> &facts_out);
+  void backup_stm_fact_maps(StatementTable<FactVec> &facts_in,
+                            StatementTable<FactVec> &facts_out) const;
   void restore_stm_fact_maps(const Statement *stm,
-                             map<const Statement *, FactVec> &facts_in,
-                             map<const Statement *, FactVec> &facts_out);
+                             const StatementTable<FactVec> &facts_in,
+                             const StatementTable<FactVec> &facts_out);
   void reset_stm_fact_maps(const Statement *stm);
 
   void output_assertions(std::ostream &out, const Statement *stm, int indent,
@@ -154,24 +219,56 @@ public:
 
   void sanity_check_map() const;
 
-  static std::vector<Fact *> meta_facts;
+  /* dense index of a statement of this function in the tables below */
+  size_t get_slot(const Statement *stm) const;
+  int find_slot(const Statement *stm) const;
+  const Statement *get_slot_stm(size_t slot) const { return slot_stms[slot]; }
+
+  static thread_local std::vector<Fact *> meta_facts;
 
   // maps to track facts and effects at historical generation points.
   // they are used for bypassing analyzing statements if possible
-  std::map<const Statement *, FactVec> map_facts_in;
-  std::map<const Statement *, FactVec> map_facts_out;
-  std::map<const Statement *, std::vector<Fact *>> map_facts_in_final;
-  std::map<const Statement *, std::vector<Fact *>> map_facts_out_final;
-  std::map<const Statement *, Effect> map_stm_effect;
-  std::map<const Statement *, Effect> map_accum_effect;
-  std::map<const Statement *, bool> map_visited;
+  StatementTable<FactVec> map_facts_in;
+  StatementTable<FactVec> map_facts_out;
+  StatementTable<std::vector<Fact *>> map_facts_in_final;
+  StatementTable<std::vector<Fact *>> map_facts_out_final;
+  StatementTable<Effect> map_stm_effect;
+  StatementTable<Effect> map_accum_effect;
+  StatementTable<bool> map_visited;
 
   std::vector<const CFGEdge *> cfg_edges;
   FactVec global_facts;
 
   const Function *func;
+
+private:
+  // statements in order of their slots
+  mutable std::vector<const Statement *> slot_stms;
+
+  // most recent first
+  std::deque<CallSummary> call_summaries;
 };
 
+template <typename T>
+T &StatementTable<T>::operator[](const Statement *s) {
+  size_t i = fm_->get_slot(s);
+  if (i >= values_.size()) {
+    values_.resize(i + 1);
+    present_.resize(i + 1, false);
+  }
+  present_[i] = true;
+  return values_[i];
+}
+
+template <typename T>
+const T *StatementTable<T>::find(const Statement *s) const {
+  int i = fm_->find_slot(s);
+  if (i < 0 || (size_t)i >= values_.size() || !present_[i]) {
+    return nullptr;
+  }
+  return &values_[i];
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 #endif // FACT_MGR_H
@@ -64,8 +64,16 @@ const Variable *FactPointTo::garbage_ptr =
     VariableSelector::make_dummy_static_variable("garbage");
 const Variable *FactPointTo::tbd_ptr =
     VariableSelector::make_dummy_static_variable("tbd");
-vector<const Variable *> FactPointTo::all_ptrs;
-vector<vector<const Variable *>> FactPointTo::all_aliases;
+thread_local vector<const Variable *> FactPointTo::all_ptrs;
+thread_local vector<vector<const Variable *>> FactPointTo::all_aliases;
+thread_local std::unordered_multimap<size_t, const FactPointTo *>
+    FactPointTo::interned_;
+
+void FactPointTo::doFinalization() {
+  all_ptrs.clear();
+  all_aliases.clear();
+  interned_.clear();
+}
 
 bool FactPointTo::is_null() const {
   for (size_t i = 0; i < point_to_vars.size(); i++) {
@@ -302,24 +310,68 @@ Fact *FactPointTo::clone(void) const {
   return fact;
 }
 
-FactPointTo *FactPointTo::make_fact(const Variable *v) {
-  FactPointTo *fact = new FactPointTo(v);
-  facts_.push_back(fact);
-  return fact;
+size_t FactPointTo::compute_fingerprint(const Variable *v,
+                                        const vector<const Variable *> &set) {
+  // sum over the pointees so that the order of the set does not matter,
+  // matching equal_variable_sets
+  size_t h = hash_ptr(v) * 31 + static_cast<size_t>(eFactCategory::ePointTo);
+  for (size_t i = 0; i < set.size(); i++) {
+    h += hash_ptr(set[i]);
+  }
+  return h;
 }
 
-FactPointTo *FactPointTo::make_fact(const Variable *v,
-                                    const vector<const Variable *> &set) {
-  FactPointTo *fact = new FactPointTo(v, set);
-  facts_.push_back(fact);
-  return fact;
+const FactPointTo *
+FactPointTo::find_interned(const Variable *v,
+                           const vector<const Variable *> &set, size_t fp) {
+  auto range = interned_.equal_range(fp);
+  for (auto i = range.first; i != range.second; ++i) {
+    const FactPointTo *f = i->second;
+    if (f->var == v && f->point_to_vars == set) {
+      return f;
+    }
+  }
+  return nullptr;
 }
 
-FactPointTo *FactPointTo::make_fact(const Variable *v,
-                                    const Variable *point_to) {
-  FactPointTo *fact = new FactPointTo(v, point_to);
-  facts_.push_back(fact);
-  return fact;
+/*
+ * facts are shared: the interned instance keeps the exact order of the
+ * point-to list, since that order shows up in the output
+ */
+const Fact *FactPointTo::intern(void) {
+  const FactPointTo *f = find_interned(var, point_to_vars, fingerprint_);
+  if (f == nullptr) {
+    interned_.emplace(fingerprint_, this);
+    return this;
+  }
+  if (f != this) {
+    discard(this);
+  }
+  return f;
+}
+
+const FactPointTo *FactPointTo::make_fact(const Variable *v) {
+  vector<const Variable *> set(1, garbage_ptr);
+  return make_fact(v, set);
+}
+
+const FactPointTo *
+FactPointTo::make_fact(const Variable *v, const vector<const Variable *> &set) {
+  size_t fp = compute_fingerprint(v, set);
+  const FactPointTo *f = find_interned(v, set, fp);
+  if (f == nullptr) {
+    FactPointTo *fact = new FactPointTo(v, set);
+    facts_.push_back(fact);
+    interned_.emplace(fp, fact);
+    f = fact;
+  }
+  return f;
+}
+
+const FactPointTo *FactPointTo::make_fact(const Variable *v,
+                                          const Variable *point_to) {
+  vector<const Variable *> set(1, point_to);
+  return make_fact(v, set);
 }
 
 vector<const Fact *>
@@ -357,13 +409,16 @@ FactPointTo::make_facts(const vector<const Variable *> &vars,
 FactPointTo::FactPointTo(const Variable *v) : Fact(eFactCategory::ePointTo), var(v) {
   // every pointer starts from un-initialized state
   point_to_vars.push_back(garbage_ptr);
+  update_fingerprint();
 }
 
 /*
  *
  */
 FactPointTo::FactPointTo(const Variable *v, const vector<const Variable *> &set)
-    : Fact(eFactCategory::ePointTo), var(v), point_to_vars(set) {}
+    : Fact(eFactCategory::ePointTo), var(v), point_to_vars(set) {
+  update_fingerprint();
+}
 
 /*
  *
@@ -371,6 +426,7 @@ FactPointTo::FactPointTo(const Variable *v, const vector<const Variable *> &set)
 FactPointTo::FactPointTo(const Variable *v, const Variable *point_to)
     : Fact(eFactCategory::ePointTo), var(v) {
   point_to_vars.push_back(point_to);
+  update_fingerprint();
 }
 
 #if 0
@@ -541,8 +597,14 @@ std::string FactPointTo::point_to_str(const Variable *v) {
 }
 
 bool FactPointTo::equal(const Fact &f) const {
+  if (this == &f) {
+    return true;
+  }
   if (eCat == f.eCat) {
     const FactPointTo &fact = (const FactPointTo &)f;
+    if (fingerprint_ != fact.fingerprint_) {
+      return false;
+    }
     return (var == fact.get_var() &&
             equal_variable_sets(point_to_vars, fact.get_point_to_vars()));
   }
@@ -566,6 +628,9 @@ int FactPointTo::join(const Fact &f) {
         changed = 1;
       }
     }
+    if (changed) {
+      update_fingerprint();
+    }
   }
   return changed;
 }
@@ -591,6 +656,7 @@ int FactPointTo::join_visits(const Fact &f) {
           changed = 1;
         }
       }
+      update_fingerprint();
     }
   }
   return changed;
@@ -795,9 +861,11 @@ void FactPointTo::aggregate_all_pointto_sets(void) {
     if (funcs[i]->is_builtin)
       continue;
     FactMgr *fm = get_fact_mgr_for_func(funcs[i]);
-    for (auto iter = fm->map_facts_out_final.begin();
-         iter != fm->map_facts_out_final.end(); ++iter) {
-      update_ptr_aliases(iter->second, all_ptrs, all_aliases);
+    for (size_t j = 0; j < fm->map_facts_out_final.size(); j++) {
+      if (fm->map_facts_out_final.has_slot(j)) {
+        update_ptr_aliases(fm->map_facts_out_final.at_slot(j), all_ptrs,
+                           all_aliases);
+      }
     }
   }
   assert(all_ptrs.size() == all_aliases.size());
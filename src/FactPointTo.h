@@ -34,6 +34,7 @@
 
 #include "Fact.h"
 #include <ostream>
+#include <unordered_map>
 #include <vector>
 
 class Variable;
@@ -48,10 +49,11 @@ class StatementReturn;
 
 class FactPointTo : public Fact {
 public:
-  static FactPointTo *make_fact(const Variable *v);
-  static FactPointTo *make_fact(const Variable *v,
-                                const vector<const Variable *> &set);
-  static FactPointTo *make_fact(const Variable *v, const Variable *point_to);
+  static const FactPointTo *make_fact(const Variable *v);
+  static const FactPointTo *make_fact(const Variable *v,
+                                      const vector<const Variable *> &set);
+  static const FactPointTo *make_fact(const Variable *v,
+                                      const Variable *point_to);
   static vector<const Fact *> make_facts(const vector<const Variable *> &vars,
                                          const vector<const Variable *> &set);
   static vector<const Fact *> make_facts(const vector<const Variable *> &vars,
@@ -94,7 +96,10 @@ public:
   virtual bool is_bottom(void) const override {
     return false;
   } // there is no bottom, we just grow the points-to set
-  virtual void set_top(void) override { point_to_vars.clear(); }
+  virtual void set_top(void) override {
+    point_to_vars.clear();
+    update_fingerprint();
+  }
   virtual void set_bottom(void) override {};
 
   virtual int join(const Fact &fact) override;
@@ -103,6 +108,8 @@ public:
   virtual bool imply(const Fact &fact) const override;
   virtual bool point_to(const Variable *v) const;
   virtual bool equal(const Fact &fact) const override;
+  virtual size_t fingerprint(void) const override { return fingerprint_; }
+  virtual const Fact *intern(void) override;
   virtual void Output(std::ostream &out) const override;
   virtual bool is_assertable(const Statement *s) const override;
 
@@ -140,16 +147,32 @@ public:
   static const Variable *garbage_ptr;
   static const Variable *tbd_ptr;
 
-  static vector<const Variable *> all_ptrs;
-  static vector<vector<const Variable *>> all_aliases;
+  static thread_local vector<const Variable *> all_ptrs;
+  static thread_local vector<vector<const Variable *>> all_aliases;
 
 private:
   FactPointTo(const Variable *v, const vector<const Variable *> &set);
   FactPointTo(const Variable *v, const Variable *point_to);
 
+  static const FactPointTo *
+  find_interned(const Variable *v, const vector<const Variable *> &set,
+                size_t fp);
+  static size_t compute_fingerprint(const Variable *v,
+                                    const vector<const Variable *> &set);
+  void update_fingerprint(void) {
+    fingerprint_ = compute_fingerprint(var, point_to_vars);
+  }
+
   const Variable *var;
   vector<const Variable *> point_to_vars;
 
+  // cached, independent of the order of point_to_vars
+  size_t fingerprint_;
+
+  // one shared instance per (var, point-to list), keyed by fingerprint
+  static thread_local std::unordered_multimap<size_t, const FactPointTo *>
+      interned_;
+
   static void update_ptr_aliases(const vector<Fact *> &facts,
                                  vector<const Variable *> &ptrs,
                                  vector<vector<const Variable *>> &aliases);
@@ -47,6 +47,8 @@
 
 const int FactUnion::TOP = -2;
 const int FactUnion::BOTTOM = -1;
+thread_local std::unordered_multimap<size_t, const FactUnion *>
+    FactUnion::interned_;
 
 /*
  * constructor
@@ -159,13 +161,45 @@ Fact *FactUnion::clone(void) const {
   return fact;
 }
 
-FactUnion *FactUnion::make_fact(const Variable *v, int fid) {
+const FactUnion *FactUnion::find_interned(const Variable *v, int fid,
+                                          size_t fp) {
+  auto range = interned_.equal_range(fp);
+  for (auto i = range.first; i != range.second; ++i) {
+    const FactUnion *f = i->second;
+    if (f->var == v && f->last_written_fid == fid) {
+      return f;
+    }
+  }
+  return nullptr;
+}
+
+const FactUnion *FactUnion::make_fact(const Variable *v, int fid) {
   assert(v == nullptr || v->type->eType == eTypeDesc::eUnion);
-  FactUnion *fact = new FactUnion(v, fid);
-  facts_.push_back(fact);
-  return fact;
+  FactUnion tmp(v, fid);
+  const FactUnion *f = find_interned(v, fid, tmp.fingerprint());
+  if (f == nullptr) {
+    FactUnion *fact = new FactUnion(v, fid);
+    facts_.push_back(fact);
+    interned_.emplace(fact->fingerprint(), fact);
+    f = fact;
+  }
+  return f;
 }
 
+const Fact *FactUnion::intern(void) {
+  const FactUnion *f = find_interned(var, last_written_fid, fingerprint());
+  if (f == nullptr) {
+    interned_.emplace(fingerprint(), this);
+    return this;
+  }
+  if (f != this) {
+    discard(this);
+  }
+  return f;
+}
+
+void FactUnion::doFinalization() { interned_.clear(); }
+
 vector<const Fact *> FactUnion::make_facts(const vector<const Variable *> &vars,
                                            int fid) {
   vector<const Fact *> facts;
@@ -193,6 +227,9 @@ bool FactUnion::is_nonreadable_field(const Variable *v,
 }
 
 bool FactUnion::equal(const Fact &f) const {
+  if (this == &f) {
+    return true;
+  }
   if (is_related(f)) {
     const FactUnion &fact = (const FactUnion &)f;
     return last_written_fid == fact.get_last_written_fid();
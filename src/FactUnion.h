@@ -34,6 +34,7 @@
 #include "Fact.h"
 #include "Variable.h"
 #include <ostream>
+#include <unordered_map>
 #include <vector>
 
 class Function;
@@ -46,7 +47,7 @@ class StatementReturn;
 
 class FactUnion : public Fact {
 public:
-  static FactUnion *make_fact(const Variable *v, int fid = 0);
+  static const FactUnion *make_fact(const Variable *v, int fid = 0);
   static vector<const Fact *> make_facts(const vector<const Variable *> &vars,
                                          int fid);
   static void doFinalization();
@@ -73,6 +74,10 @@ public:
   virtual void set_bottom(void) override { last_written_fid = BOTTOM; }
   virtual bool imply(const Fact &fact) const override;
   virtual bool equal(const Fact &fact) const override;
+  virtual size_t fingerprint(void) const override {
+    return hash_ptr(var) * 31 + static_cast<size_t>(last_written_fid);
+  }
+  virtual const Fact *intern(void) override;
   virtual int join(const Fact &fact) override;
 
   // transfer functions
@@ -105,10 +110,16 @@ private:
   FactUnion(const Variable *v);
   FactUnion(const Variable *v, int fid);
 
+  static const FactUnion *find_interned(const Variable *v, int fid, size_t fp);
+
   const Variable *var;
 
   // last written field id
   int last_written_fid;
+
+  // one shared instance per (var, field id), keyed by fingerprint
+  static thread_local std::unordered_multimap<size_t, const FactUnion *>
+      interned_;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
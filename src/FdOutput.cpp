@@ -0,0 +1,142 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2026 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <config.h>
+
+#include "FdOutput.h"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#ifdef WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+// large enough that a typical program is written with a handful of calls
+static const size_t buffer_size = 1 << 20;
+
+FdOutput::Buf::Buf(int fd, bool owned)
+    : fd_(fd), owned_(owned), buf_(buffer_size) {
+  setp(buf_.data(), buf_.data() + buf_.size());
+}
+
+bool FdOutput::Buf::write_all(const char *s, size_t n) {
+  while (n > 0) {
+    const auto written = ::write(fd_, s, n);
+    if (written < 0) {
+      if (errno == EINTR)
+        continue;
+      return false;
+    }
+    s += written;
+    n -= written;
+  }
+  return true;
+}
+
+bool FdOutput::Buf::drain(void) {
+  if (fd_ < 0)
+    return false;
+  const bool ok = write_all(pbase(), pptr() - pbase());
+  setp(buf_.data(), buf_.data() + buf_.size());
+  return ok;
+}
+
+bool FdOutput::Buf::close(void) {
+  if (fd_ < 0)
+    return true;
+  bool ok = drain();
+  if (owned_ && ::close(fd_) != 0)
+    ok = false;
+  fd_ = -1;
+  return ok;
+}
+
+FdOutput::Buf::int_type FdOutput::Buf::overflow(int_type c) {
+  if (!drain())
+    return traits_type::eof();
+  if (!traits_type::eq_int_type(c, traits_type::eof())) {
+    *pptr() = traits_type::to_char_type(c);
+    pbump(1);
+  }
+  return traits_type::not_eof(c);
+}
+
+streamsize FdOutput::Buf::xsputn(const char *s, streamsize n) {
+  if (fd_ < 0)
+    return 0;
+  if (n <= epptr() - pptr()) {
+    memcpy(pptr(), s, n);
+    pbump(static_cast<int>(n));
+    return n;
+  }
+  // too big for what is left: write the buffer, then s itself unless it fits
+  if (!drain())
+    return 0;
+  if (static_cast<size_t>(n) >= buf_.size())
+    return write_all(s, n) ? n : 0;
+  memcpy(pptr(), s, n);
+  pbump(static_cast<int>(n));
+  return n;
+}
+
+FdOutput::FdOutput(int fd, bool owned)
+    : std::ostream(nullptr), buf_(fd, owned) {
+  rdbuf(&buf_);
+  if (fd < 0)
+    setstate(badbit);
+}
+
+FdOutput::FdOutput(const std::string &path)
+    : FdOutput(::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666),
+               true) {}
+
+FdOutput::~FdOutput() { buf_.close(); }
+
+void FdOutput::drain(void) {
+  if (!buf_.drain())
+    setstate(badbit);
+}
+
+void FdOutput::close(void) {
+  if (!buf_.close())
+    setstate(badbit);
+}
+
+// Local Variables:
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+
+// End of file.
@@ -0,0 +1,100 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2026 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef FD_OUTPUT_H
+#define FD_OUTPUT_H
+
+///////////////////////////////////////////////////////////////////////////////
+
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+ * An output stream writing to a file descriptor through a large buffer, for
+ * the generated programs. The output code ends almost every line with
+ * std::endl, which makes std::cout and std::ofstream issue a write for every
+ * line; here flushing does nothing, and the buffer is only written when it is
+ * full, by drain(), and by close() or the destructor.
+ */
+class FdOutput : public std::ostream {
+public:
+  // write to fd, which is closed at the end if owned
+  explicit FdOutput(int fd, bool owned = false);
+
+  // create or truncate path; check good() for errors
+  explicit FdOutput(const std::string &path);
+
+  ~FdOutput();
+
+  // write everything buffered so far, e.g., to let a reader at the other end
+  // of a pipe see a complete program
+  void drain(void);
+
+  // drain, and close the file descriptor if owned
+  void close(void);
+
+private:
+  class Buf : public std::streambuf {
+  public:
+    Buf(int fd, bool owned);
+
+    bool drain(void);
+    bool close(void);
+
+  protected:
+    int_type overflow(int_type c);
+    std::streamsize xsputn(const char *s, std::streamsize n);
+    int sync(void) { return 0; }
+
+  private:
+    bool write_all(const char *s, size_t n);
+
+    int fd_;
+    bool owned_;
+    std::vector<char> buf_;
+  };
+
+  Buf buf_;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // FD_OUTPUT_H
+
+// Local Variables:
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+
+// End of file.
@@ -31,15 +31,25 @@
 
 #include "Finalization.h"
 
+#include "ArrayVariable.h"
 #include "Bookkeeper.h"
+#include "Error.h"
+#include "Expression.h"
 #include "ExtensionMgr.h"
 #include "Function.h"
 #include "FunctionInvocationUser.h"
+#include "GenBudget.h"
+#include "NodePool.h"
 #include "Probabilities.h"
+#include "Profiler.h"
 #include "RandomNumber.h"
+#include "SafeOpFlags.h"
+#include "Statement.h"
+#include "StatementAssign.h"
 #include "StatementGoto.h"
 #include "Type.h"
 #include "VariableSelector.h"
+#include "util.h"
 
 void Finalization::doFinalization() {
   Function::doFinalization();
@@ -51,4 +61,18 @@ void Finalization::doFinalization() {
   Probabilities::DestroyInstance();
   StatementGoto::doFinalization();
   ExtensionMgr::DestroyExtension();
+  // the remaining state only matters when another program is generated
+  // in the same process, e.g., in batch mode
+  ArrayVariable::doFinalization();
+  Expression::doFinalization();
+  Statement::doFinalization();
+  StatementAssign::doFinalization();
+  SafeOpFlags::doFinalization();
+  Bookkeeper::doFinalization();
+  Profiler::doFinalization();
+  GenBudget::doFinalization();
+  Error::set_error(SUCCESS);
+  reset_gensym();
+  // last, as everything above may still delete nodes
+  NodePool::doFinalization();
 }
@@ -58,7 +58,9 @@
 #include "Fact.h"
 #include "FactMgr.h"
 #include "FactPointTo.h"
+#include "GenBudget.h"
 #include "OutputMgr.h"
+#include "Profiler.h"
 #include "Statement.h"
 #include "Type.h"
 #include "VariableSelector.h"
@@ -70,11 +72,13 @@ using namespace std;
 
 ///////////////////////////////////////////////////////////////////////////////
 
-AttributeGenerator func_attr_generator;
-static vector<Function *> FuncList; // List of all functions in the program
-static vector<FactMgr *> FMList;    // list of fact managers for each function
-static bool param_first = true; // Flag to track output of commas
-static int builtin_functions_cnt;
+thread_local AttributeGenerator func_attr_generator;
+// List of all functions in the program
+static thread_local vector<Function *> FuncList;
+// list of fact managers for each function
+static thread_local vector<FactMgr *> FMList;
+static thread_local bool param_first = true; // Flag to track output of commas
+static thread_local int builtin_functions_cnt;
 
 static std::vector<string> common_func_attributes;
 
@@ -225,7 +229,8 @@ bool Function::is_var_oos(const Variable *var, const Statement *stm) const {
 
 bool Function::reach_max_functions_cnt() {
   return ((static_cast<int>(FuncList.size()) - builtin_functions_cnt) >=
-          CGOptions::max_funcs());
+          CGOptions::max_funcs()) ||
+         GenBudget::above_max_size();
 }
 
 const vector<Function *> &get_all_functions(void) { return FuncList; }
@@ -461,6 +466,7 @@ Function *Function::make_first(void) {
 
   // No Parameter List
   f->GenerateBody(CGContext::get_empty_context());
+  ERROR_GUARD(nullptr);
   if (CGOptions::inline_function() && rnd_flipcoin(InlineFunctionProb()))
     f->is_inlined = true;
   fm->setup_in_out_maps(true);
@@ -623,6 +629,7 @@ bool Function::need_return_stmt() {
  *
  */
 void Function::GenerateBody(const CGContext &prev_context) {
+  ProfileScope scope(eProfPhase::eFunctionBody);
   if (build_state != BuildState::Unbuilt) {
     cerr << "warning: ignoring attempt to regenerate func" << endl;
     return;
@@ -665,6 +672,7 @@ void Function::GenerateBody(const CGContext &prev_context) {
 
 void Function::generate_body_with_known_params(const CGContext &prev_context,
                                                Effect &effect_accum) {
+  ProfileScope scope(eProfPhase::eFunctionBody);
   if (build_state != BuildState::Unbuilt) {
     cerr << "warning: ignoring attempt to regenerate func" << endl;
     return;
@@ -788,6 +796,7 @@ void Function::compute_summary(void) {
  *
  */
 void GenerateFunctions(void) {
+  ProfileScope scope(eProfPhase::eFunctions);
   FactMgr::add_interested_facts(CGOptions::interested_facts());
   if (CGOptions::builtins())
     Function::initialize_builtin_functions();
@@ -798,6 +807,12 @@ void GenerateFunctions(void) {
 
   // -----------------
   // Create body of each function, continue until no new functions are created.
+  //
+  // This cannot be spread over threads: a new callee gets its body at the
+  // call site (FunctionInvocationUser::build_invocation_and_function), from
+  // the caller's facts and effect context, and the callee's output facts and
+  // effect steer the rest of the caller. Together with the single random
+  // number stream, every body depends on everything generated before it.
   for (long cur_func_idx = 0; cur_func_idx < FuncListSize(); cur_func_idx++) {
     // Dynamically adds new functions to the end of the list..
     if (FuncList[cur_func_idx]->is_built() == false) {
@@ -854,12 +869,17 @@ void Function::doFinalization(void) {
   }
   FMList.clear();
   FactMgr::doFinalization();
+  func_attr_generator.clear();
+  builtin_functions_cnt = 0;
+  param_first = true;
 }
 
 Function::~Function() {
   param.clear();
 
-  assert(stack.empty());
+  // a function whose generation was given up (see GenBudget) can still have
+  // blocks on its stack
+  assert(stack.empty() || build_state == BuildState::Building);
 
   if (body) {
     delete body;
@@ -98,6 +98,7 @@ FunctionInvocation *FunctionInvocation::make_random(bool is_std_func,
     } else if (!Function::reach_max_functions_cnt()) {
       fi = FunctionInvocationUser::build_invocation_and_function(cg_context,
                                                                  type, qfer);
+      ERROR_GUARD(nullptr);
     } else {
       // we can not find/create a function because we reach the limit, so give
       // up
@@ -115,6 +116,7 @@ FunctionInvocation *FunctionInvocation::make_random(bool is_std_func,
     } else {
       fi = make_random_binary(cg_context, type);
     }
+    ERROR_GUARD(nullptr);
   }
   assert(fi != 0);
   return fi;
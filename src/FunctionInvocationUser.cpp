@@ -58,6 +58,7 @@
 #include "FactMgr.h"
 #include "Function.h"
 #include "Lhs.h"
+#include "Profiler.h"
 #include "SafeOpFlags.h"
 #include "Statement.h"
 #include "StatementAssign.h"
@@ -67,11 +68,11 @@
 
 using namespace std;
 
-static vector<bool> needcomma; // Flag to track output of commas
+static thread_local vector<bool> needcomma; // Flag to track output of commas
 
-static vector<const FunctionInvocationUser *>
+static thread_local vector<const FunctionInvocationUser *>
     invocations;                          // list of function calls
-static vector<const Fact *> return_facts; // list of return facts
+static thread_local vector<const Fact *> return_facts; // list of return facts
 
 const Fact *get_return_fact_for_invocation(const FunctionInvocationUser *fiu,
                                            const Variable *var,
@@ -176,6 +177,7 @@ FunctionInvocationUser *FunctionInvocationUser::build_invocation_and_function(
   FactMgr *caller_fm = get_fact_mgr(&cg_context);
   Effect running_eff_context(cg_context.get_effect_context());
   Function *func = Function::make_random_signature(cg_context, type, qfer);
+  ERROR_GUARD(nullptr);
 
   vector<const Expression *> param_values;
   for (size_t i = 0; i < func->param.size(); i++) {
@@ -319,23 +321,47 @@ bool FunctionInvocationUser::revisit(std::vector<const Fact *> &inputs,
   // add facts related to pass parameters
   fm->caller_to_callee_handover(this, inputs);
 
-  map<const Statement *, FactVec> facts_in_copy = fm->map_facts_in;
-  map<const Statement *, FactVec> facts_out_copy = fm->map_facts_out;
-  map<const Statement *, Effect> stm_effect_copy = fm->map_stm_effect;
-  map<const Statement *, Effect> accum_effect_copy = fm->map_accum_effect;
-  // TODO: revisit only if "contingent variable" has been changed?
-  if (!func->body->visit_facts(inputs, cg_context)) {
-    // restore facts and effect
-    fm->map_facts_in = facts_in_copy;
-    fm->map_facts_out = facts_out_copy;
-    fm->map_stm_effect = stm_effect_copy;
-    fm->map_accum_effect = accum_effect_copy;
-    inputs = inputs_copy;
-    return false;
-  }
-  cg_context.add_effect(fm->map_stm_effect[func->body]);
   FactVec ret_facts;
-  func->body->add_back_return_facts(fm, ret_facts);
+  // like the statement shortcut (Statement::shortcut_analysis), but keyed by
+  // the facts the body can see, for several earlier calls instead of the last
+  // one only. A hit leaves the statement maps of fm as they are: the facts of
+  // that earlier call are already combined into the final maps
+  FactVec relevant;
+  vector<const Variable *> roots;
+  const CallSummary *summary = nullptr;
+  if (func->is_built()) {
+    fm->find_relevant_facts(inputs, relevant, roots);
+    summary = fm->find_call_summary(relevant, cg_context);
+  }
+  if (summary && !cg_context.in_conflict(summary->effect)) {
+    Profiler::incr(eProfCounter::eCallSummaryHits);
+    FactMgr::apply_call_summary(*summary, inputs);
+    ret_facts = summary->return_facts;
+    cg_context.add_effect(summary->effect, true);
+  } else {
+    Profiler::incr(eProfCounter::eCallSummaryMisses);
+    StatementTable<FactVec> facts_in_copy = fm->map_facts_in;
+    StatementTable<FactVec> facts_out_copy = fm->map_facts_out;
+    StatementTable<Effect> stm_effect_copy = fm->map_stm_effect;
+    StatementTable<Effect> accum_effect_copy = fm->map_accum_effect;
+    if (!func->body->visit_facts(inputs, cg_context)) {
+      // restore facts and effect
+      fm->map_facts_in = facts_in_copy;
+      fm->map_facts_out = facts_out_copy;
+      fm->map_stm_effect = stm_effect_copy;
+      fm->map_accum_effect = accum_effect_copy;
+      inputs = inputs_copy;
+      return false;
+    }
+    cg_context.add_effect(fm->map_stm_effect[func->body]);
+    func->body->add_back_return_facts(fm, ret_facts);
+    // the callers start with an empty effect_accum: what the visit added to
+    // it is what the callee's feffect picks up
+    if (func->is_built() && !summary)
+      fm->add_call_summary(relevant, cg_context, roots, inputs, ret_facts,
+                           *cg_context.get_effect_accum());
+    fm->setup_in_out_maps(false);
+  }
   save_return_fact(ret_facts);
   // incorporate early return facts
   merge_facts(inputs, ret_facts);
@@ -343,7 +369,6 @@ bool FunctionInvocationUser::revisit(std::vector<const Fact *> &inputs,
   // remove facts related to passing parameters
   FactMgr::update_facts_for_oos_vars(func->param, inputs);
 
-  fm->setup_in_out_maps(false);
   // remember the effect context during this visit to this function
   func->accum_eff_context.add_external_effect(cg_context.get_effect_context());
   // update the original facts with new facts changed by function call
@@ -0,0 +1,110 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2026 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include <config.h>
+
+#include "GenBudget.h"
+
+#include <chrono>
+
+#include "CGOptions.h"
+#include "Statement.h"
+
+using namespace std;
+
+thread_local int64_t GenBudget::deadline_ = 0;
+
+// Rough size of the printed program: the fixed part (header, platform
+// macros, main and the checksum code) plus an average number of bytes per
+// statement, measured on programs generated with the default options.
+static const size_t fixed_bytes = 2500;
+static const size_t bytes_per_statement = 120;
+
+static int64_t now_nanoseconds(void) {
+  return chrono::duration_cast<chrono::nanoseconds>(
+             chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool GenBudget::enabled(void) {
+  return CGOptions::min_size() > 0 || CGOptions::max_size() > 0 ||
+         CGOptions::max_gen_ms() > 0;
+}
+
+void GenBudget::start(void) {
+  deadline_ = 0;
+  if (CGOptions::max_gen_ms() > 0) {
+    deadline_ = now_nanoseconds() +
+                static_cast<int64_t>(CGOptions::max_gen_ms()) * 1000000;
+  }
+}
+
+size_t GenBudget::estimated_size(void) {
+  return fixed_bytes + bytes_per_statement * Statement::get_current_sid();
+}
+
+bool GenBudget::below_min_size(void) {
+  return CGOptions::min_size() > 0 &&
+         estimated_size() < static_cast<size_t>(CGOptions::min_size());
+}
+
+bool GenBudget::above_max_size(void) {
+  return CGOptions::max_size() > 0 &&
+         estimated_size() >= static_cast<size_t>(CGOptions::max_size());
+}
+
+void GenBudget::check_deadline(void) {
+  if (now_nanoseconds() > deadline_) {
+    deadline_ = 0;
+    throw Exceeded();
+  }
+}
+
+bool GenBudget::fits(size_t bytes) {
+  if (CGOptions::min_size() > 0 &&
+      bytes < static_cast<size_t>(CGOptions::min_size()))
+    return false;
+  if (CGOptions::max_size() > 0 &&
+      bytes > static_cast<size_t>(CGOptions::max_size()))
+    return false;
+  return true;
+}
+
+void GenBudget::doFinalization(void) { deadline_ = 0; }
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Local Variables:
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+
+// End of file.
@@ -0,0 +1,103 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2026 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef GEN_BUDGET_H
+#define GEN_BUDGET_H
+
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <cstdint>
+
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+ * Size and time budget of the program being generated (--min-size,
+ * --max-size and --max-gen-ms).
+ *
+ * The size is steered while generating, from an estimate based on the number
+ * of statements created so far: function bodies are filled up and blocks are
+ * not ended by random return statements while the program is estimated to be
+ * smaller than the minimum, and no new functions or statements are created
+ * once it is estimated to be larger than the maximum. The exact size is checked after the program has
+ * been printed.
+ *
+ * Running out of time cannot be steered without making the program depend on
+ * the speed of the machine, so check_time throws GenBudget::Exceeded instead,
+ * which unwinds the whole generator. The caller gives up on the program and
+ * exits with GenBudget::exit_code.
+ */
+class GenBudget {
+public:
+  // exit status of csmith for a program that does not fit the budget
+  static const int exit_code = 3;
+
+  struct Exceeded {};
+
+  // true if any of the budget options is given
+  static bool enabled(void);
+
+  // start the clock for a new program
+  static void start(void);
+
+  static bool below_min_size(void);
+  static bool above_max_size(void);
+
+  // throw Exceeded if the program is out of time
+  static void check_time(void) {
+    if (deadline_ != 0)
+      check_deadline();
+  }
+
+  // whether a printed program of the given size is within bounds
+  static bool fits(size_t bytes);
+
+  static void doFinalization(void);
+
+private:
+  GenBudget();
+  ~GenBudget();
+
+  static void check_deadline(void);
+  static size_t estimated_size(void);
+
+  // steady_clock time in nanoseconds, 0 if there is no time limit
+  static thread_local int64_t deadline_;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // GEN_BUDGET_H
+
+// Local Variables:
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+
+// End of file.
@@ -54,27 +54,48 @@ LinearSequence::~LinearSequence() {
  */
 void LinearSequence::init_sequence() {}
 
-void LinearSequence::add_number(int v, int /*bound*/, int k) {
-  seq_map_[k] = v;
+void LinearSequence::add_number(int v, int bound, int k) {
+  assert(k >= 0);
+  const size_t pos = static_cast<size_t>(k);
+  if (pos >= values_.size()) {
+    values_.resize(pos + 1, 0);
+    bounds_.resize(pos + 1, 0);
+  }
+  values_[pos] = v;
+  bounds_[pos] = bound;
 }
 
 int LinearSequence::get_number(int /*bound*/) { return -1; }
 
+/*
+ * A position that was never added reads as choice 0.
+ */
 int LinearSequence::get_number_by_pos(int pos) {
-  int rv = seq_map_[pos];
+  if (pos < 0 || static_cast<size_t>(pos) >= values_.size())
+    return 0;
+  int rv = values_[pos];
   assert(rv >= 0);
   return rv;
 }
 
-void LinearSequence::clear() { seq_map_.clear(); }
+int LinearSequence::get_bound_by_pos(int pos) {
+  if (pos < 0 || static_cast<size_t>(pos) >= bounds_.size())
+    return 0;
+  return bounds_[pos];
+}
+
+void LinearSequence::clear() {
+  values_.clear();
+  bounds_.clear();
+}
 
 void LinearSequence::get_sequence(ostream &ss) {
-  assert(!seq_map_.empty());
+  assert(!values_.empty());
 
-  for (size_t i = 0; i < seq_map_.size() - 1; ++i) {
-    ss << seq_map_[i] << sep_char_;
+  for (size_t i = 0; i < values_.size() - 1; ++i) {
+    ss << values_[i] << sep_char_;
   }
-  ss << seq_map_[seq_map_.size() - 1];
+  ss << values_.back();
 }
 
-unsigned INT64 LinearSequence::sequence_length() { return seq_map_.size(); }
+unsigned INT64 LinearSequence::sequence_length() { return values_.size(); }
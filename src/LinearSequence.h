@@ -30,8 +30,8 @@
 #ifndef LINEAR_SEQUENCE_H
 #define LINEAR_SEQUENCE_H
 
-#include <map>
 #include <string>
+#include <vector>
 
 #include "Sequence.h"
 
@@ -51,6 +51,8 @@ public:
 
   virtual int get_number_by_pos(int pos) override;
 
+  virtual int get_bound_by_pos(int pos) override;
+
   virtual void clear() override;
 
   virtual void get_sequence(std::ostream &) override;
@@ -60,7 +62,11 @@ public:
   static const char default_sep_char;
 
 private:
-  std::map<int, int> seq_map_;
+  // The choice made at every position and its bound, 0 when unknown. The
+  // positions are those of consecutive choices, so they are stored densely.
+  std::vector<int> values_;
+
+  std::vector<int> bounds_;
 
   const char sep_char_;
 };
@@ -0,0 +1,110 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2026 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include <config.h>
+
+#include "NodePool.h"
+
+#include <cassert>
+#include <new>
+
+using namespace std;
+
+thread_local vector<char *> NodePool::chunks_;
+thread_local char *NodePool::chunk_cur_ = nullptr;
+thread_local char *NodePool::chunk_end_ = nullptr;
+thread_local NodePool::FreeNode
+    *NodePool::free_lists_[max_node_size / granularity];
+
+///////////////////////////////////////////////////////////////////////////////
+
+void *NodePool::allocate(size_t size) {
+  if (size == 0 || size > max_node_size) {
+    return ::operator new(size);
+  }
+  size_t index = (size - 1) / granularity;
+  FreeNode *node = free_lists_[index];
+  if (node) {
+    free_lists_[index] = node->next;
+    return node;
+  }
+  return allocate_from_chunk((index + 1) * granularity);
+}
+
+void *NodePool::allocate_from_chunk(size_t size) {
+  if (static_cast<size_t>(chunk_end_ - chunk_cur_) < size) {
+    // the unused tail of the current chunk (if any) is simply dropped
+    char *chunk = static_cast<char *>(::operator new(chunk_size));
+    chunks_.push_back(chunk);
+    chunk_cur_ = chunk;
+    chunk_end_ = chunk + chunk_size;
+  }
+  void *p = chunk_cur_;
+  chunk_cur_ += size;
+  return p;
+}
+
+void NodePool::deallocate(void *p, size_t size) {
+  if (!p) {
+    return;
+  }
+  if (size == 0 || size > max_node_size) {
+    ::operator delete(p);
+    return;
+  }
+  assert(!chunks_.empty());
+  size_t index = (size - 1) / granularity;
+  FreeNode *node = static_cast<FreeNode *>(p);
+  node->next = free_lists_[index];
+  free_lists_[index] = node;
+}
+
+/*
+ * Release all the memory of the pool. Every node allocated from it, deleted
+ * or not, is gone after this
+ */
+void NodePool::doFinalization(void) {
+  for (size_t i = 0; i < chunks_.size(); i++) {
+    ::operator delete(chunks_[i]);
+  }
+  chunks_.clear();
+  chunk_cur_ = chunk_end_ = nullptr;
+  for (size_t i = 0; i < max_node_size / granularity; i++) {
+    free_lists_[i] = nullptr;
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Local Variables:
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+
+// End of file.
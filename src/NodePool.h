@@ -0,0 +1,95 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2026 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef NODE_POOL_H
+#define NODE_POOL_H
+
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+ * Per-thread memory pool for the nodes of a generated program (statements,
+ * expressions, variables, facts and CFG edges). Small nodes are carved out of
+ * large chunks and recycled through one free list per size class, so building
+ * and tearing down programs does not go through malloc for every node. All the
+ * chunks are released at once by doFinalization, which also reclaims the nodes
+ * that were never deleted.
+ *
+ * Nodes that outlive a program (e.g., FactPointTo::null_ptr) must not be
+ * allocated from the pool.
+ */
+class NodePool {
+public:
+  static void *allocate(size_t size);
+  static void deallocate(void *p, size_t size);
+
+  static void doFinalization(void);
+
+private:
+  NodePool();
+  ~NodePool();
+
+  static void *allocate_from_chunk(size_t size);
+
+  struct FreeNode {
+    FreeNode *next;
+  };
+
+  // sizes are rounded up to a multiple of this, which also keeps the
+  // alignment that operator new guarantees
+  static const size_t granularity = 16;
+
+  // larger nodes go to operator new
+  static const size_t max_node_size = 512;
+
+  static const size_t chunk_size = 64 * 1024;
+
+  static thread_local std::vector<char *> chunks_;
+
+  // unused tail of the last chunk
+  static thread_local char *chunk_cur_;
+  static thread_local char *chunk_end_;
+
+  static thread_local FreeNode *free_lists_[max_node_size / granularity];
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // NODE_POOL_H
+
+// Local Variables:
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+
+// End of file.
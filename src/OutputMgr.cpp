@@ -45,7 +45,9 @@
 #include "platform.h"
 #include "random.h"
 #include "util.h"
+#include <algorithm>
 #include <cassert>
+#include <cctype>
 #include <sstream>
 
 const char *OutputMgr::hash_func_name = "csmith_compute_hash";
@@ -71,7 +73,7 @@ using namespace std;
 
 vector<string> OutputMgr::monitored_funcs_;
 
-std::string OutputMgr::curr_func_ = "";
+thread_local std::string OutputMgr::curr_func_ = "";
 
 void OutputMgr::set_curr_func(const std::string &fname) {
   OutputMgr::curr_func_ = fname;
@@ -269,6 +271,19 @@ void OutputMgr::OutputHeader(int argc, char *argv[], unsigned long seed) {
     out << "#define NO_LONGLONG" << std::endl;
     out << endl;
   }
+  // select the checksum of runtime/csmith.h
+  if (CGOptions::compute_hash() &&
+      CGOptions::checksum_kind() != CGOPTIONS_DEFAULT_CHECKSUM_KIND) {
+    string kind = CGOptions::checksum_kind();
+    std::transform(kind.begin(), kind.end(), kind.begin(), ::toupper);
+    out << "#define CSMITH_CHECKSUM_" << kind << std::endl;
+    out << endl;
+  }
+  // a --self-contained program gets the used wrappers in place of safe_math.h
+  if (CGOptions::tailored_safe_math() && !CGOptions::self_contained()) {
+    out << "#define CSMITH_TAILORED_SAFE_MATH" << std::endl;
+    out << endl;
+  }
   if (CGOptions::enable_float()) {
     out << "#include <float.h>\n";
     out << "#include <math.h>\n";
@@ -126,12 +126,15 @@ void PartialExpander::restore_init_values() {
 
 bool PartialExpander::direct_expand_check(eStatementType t) {
   // assert(expands_.find(t) != expands_.end());
-  return expands_[t];
+  auto expand = expands_.find(t);
+  return (expand != expands_.end()) && expand->second;
 }
 
 bool PartialExpander::expand_check(eStatementType t) {
-  // If expand is false, then all values are valid
-  if (!expands_[MAX_STATEMENT_TYPE])
+  // If expand is false, then all values are valid. Use find() so that the
+  // map is only read in random mode, where it is shared by all threads.
+  auto expand = expands_.find(MAX_STATEMENT_TYPE);
+  if (expand == expands_.end() || !expand->second)
     return true;
 
   assert(expands_.find(t) != expands_.end());
@@ -299,7 +299,7 @@ void GroupProbElem::dump_val(std::ostream &out) {
 
 /////////////////////////////////////////////////////////////////
 
-Probabilities *Probabilities::instance_ = nullptr;
+thread_local Probabilities *Probabilities::instance_ = nullptr;
 
 Probabilities *Probabilities::GetInstance() {
   if (Probabilities::instance_)
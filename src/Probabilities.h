@@ -407,7 +407,7 @@ private:
 
   void initialize();
 
-  static Probabilities *instance_;
+  static thread_local Probabilities *instance_;
 
   static const char comment_line_prefix;
 
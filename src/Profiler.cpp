@@ -0,0 +1,115 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2026 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include <config.h>
+
+#include "Profiler.h"
+
+#include <cassert>
+#include <chrono>
+#include <iomanip>
+
+using namespace std;
+
+bool Profiler::enabled_ = false;
+thread_local int Profiler::depths_[phase_cnt];
+thread_local uint64_t Profiler::calls_[phase_cnt];
+thread_local int64_t Profiler::starts_[phase_cnt];
+thread_local int64_t Profiler::nanoseconds_[phase_cnt];
+thread_local uint64_t Profiler::counters_[counter_cnt];
+
+// in the order of eProfPhase and eProfCounter
+static const char *phase_names[] = {"program",       "types",
+                                    "functions",     "function_body",
+                                    "fixed_point",   "output"};
+
+static const char *counter_names[] = {
+    "fixed_point_iterations", "shortcut_hits", "shortcut_conflicts",
+    "shortcut_misses", "filter_retries", "call_summary_hits",
+    "call_summary_misses", "dfs_duplicates"};
+
+static int64_t now_nanoseconds(void) {
+  return chrono::duration_cast<chrono::nanoseconds>(
+             chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void Profiler::enter(eProfPhase phase) {
+  const int p = static_cast<int>(phase);
+  calls_[p]++;
+  if (depths_[p]++ == 0) {
+    starts_[p] = now_nanoseconds();
+  }
+}
+
+void Profiler::leave(eProfPhase phase) {
+  const int p = static_cast<int>(phase);
+  assert(depths_[p] > 0);
+  if (--depths_[p] == 0) {
+    nanoseconds_[p] += now_nanoseconds() - starts_[p];
+  }
+}
+
+void Profiler::OutputJSON(std::ostream &out, unsigned long seed) {
+  out << "{\"seed\": " << seed << ", \"phases\": {";
+  for (int i = 0; i < phase_cnt; i++) {
+    out << (i ? ", " : "") << "\"" << phase_names[i] << "\": {\"ms\": "
+        << fixed << setprecision(3) << (nanoseconds_[i] / 1e6)
+        << ", \"calls\": " << calls_[i] << "}";
+  }
+  out << "}, \"counters\": {";
+  for (int i = 0; i < counter_cnt; i++) {
+    out << (i ? ", " : "") << "\"" << counter_names[i]
+        << "\": " << counters_[i];
+  }
+  out << "}}" << std::endl;
+}
+
+void Profiler::doFinalization(void) {
+  for (int i = 0; i < phase_cnt; i++) {
+    depths_[i] = 0;
+    calls_[i] = 0;
+    starts_[i] = 0;
+    nanoseconds_[i] = 0;
+  }
+  for (int i = 0; i < counter_cnt; i++) {
+    counters_[i] = 0;
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Local Variables:
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+
+// End of file.
@@ -0,0 +1,141 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2026 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+#include <ostream>
+
+/*
+ * Timed phases of the generation of a program
+ */
+enum class eProfPhase {
+  eProgram,
+  eTypes,
+  eFunctions,
+  eFunctionBody,
+  eFixedPoint,
+  eOutput,
+  MAX_PROF_PHASE
+};
+
+/*
+ * Events counted during the generation of a program
+ */
+enum class eProfCounter {
+  eFixedPointIterations,
+  eShortcutHits,
+  eShortcutConflicts,
+  eShortcutMisses,
+  eFilterRetries,
+  eCallSummaryHits,
+  eCallSummaryMisses,
+  eDfsDuplicates,
+  MAX_PROF_COUNTER
+};
+
+/*
+ * Timers and counters for the phases of the generator, reported by
+ * --stats-json. The state is per thread and reset for every program. Time is
+ * only taken by the outermost scope of a phase, so nested (or recursive) scopes
+ * are counted as calls without being timed twice.
+ */
+class Profiler {
+public:
+  static void enable(bool on) { enabled_ = on; }
+  static bool enabled(void) { return enabled_; }
+
+  static void enter(eProfPhase phase);
+  static void leave(eProfPhase phase);
+
+  static void incr(eProfCounter counter) {
+    if (enabled_) {
+      counters_[static_cast<int>(counter)]++;
+    }
+  }
+
+  // write the statistics of the current program as one line of JSON
+  static void OutputJSON(std::ostream &out, unsigned long seed);
+
+  static void doFinalization(void);
+
+private:
+  Profiler();
+  ~Profiler();
+
+  static const int phase_cnt = static_cast<int>(eProfPhase::MAX_PROF_PHASE);
+  static const int counter_cnt =
+      static_cast<int>(eProfCounter::MAX_PROF_COUNTER);
+
+  // set once, before any program is generated
+  static bool enabled_;
+
+  static thread_local int depths_[phase_cnt];
+  static thread_local uint64_t calls_[phase_cnt];
+  static thread_local int64_t starts_[phase_cnt];
+  static thread_local int64_t nanoseconds_[phase_cnt];
+  static thread_local uint64_t counters_[counter_cnt];
+};
+
+/*
+ * Times the enclosing scope as the given phase
+ */
+class ProfileScope {
+public:
+  explicit ProfileScope(eProfPhase phase) : phase_(phase) {
+    if (Profiler::enabled()) {
+      Profiler::enter(phase_);
+    }
+  }
+  ~ProfileScope(void) {
+    if (Profiler::enabled()) {
+      Profiler::leave(phase_);
+    }
+  }
+
+private:
+  ProfileScope(const ProfileScope &);
+  ProfileScope &operator=(const ProfileScope &);
+
+  const eProfPhase phase_;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // PROFILER_H
+
+// Local Variables:
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+
+// End of file.
@@ -36,7 +36,7 @@
 #include <cassert>
 #include <iostream>
 
-RandomNumber *RandomNumber::instance_ = nullptr;
+thread_local RandomNumber *RandomNumber::instance_ = nullptr;
 
 RandomNumber::RandomNumber(const unsigned long seed) : seed_(seed) {
   unsigned int count = AbsRndNumGenerator::count();
@@ -109,6 +109,10 @@ RandomNumber::SwitchRndNumGenerator(RNDNUM_GENERATOR rImpl) {
   return old;
 }
 
+bool RandomNumber::HasRndNumGenerator(RNDNUM_GENERATOR rImpl) {
+  return instance_->generators_[rImpl] != nullptr;
+}
+
 std::string RandomNumber::get_prefixed_name(const std::string &name) {
   return curr_generator_->get_prefixed_name(name);
 }
@@ -149,4 +153,5 @@ void RandomNumber::doFinalization() {
     delete generator;
   }
   delete instance_;
+  instance_ = nullptr;
 }
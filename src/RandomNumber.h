@@ -54,6 +54,9 @@ public:
   // Return the previous impl
   static RNDNUM_GENERATOR SwitchRndNumGenerator(RNDNUM_GENERATOR rImpl);
 
+  // Whether the impl was created yet
+  static bool HasRndNumGenerator(RNDNUM_GENERATOR rImpl);
+
   static void doFinalization();
 
   std::string get_prefixed_name(const std::string &name);
@@ -82,7 +85,7 @@ protected:
 
   AbsRndNumGenerator *curr_generator_;
 
-  static RandomNumber *instance_;
+  static thread_local RandomNumber *instance_;
 
   std::map<RNDNUM_GENERATOR, AbsRndNumGenerator *> generators_;
 
@@ -89,15 +89,25 @@ the pointer to pass by value)
 #pragma warning(disable : 4786) /* Disable annoying warning messages */
 #endif
 
+#include <atomic>
 #include <cstdio>
 #include <cstring>
 #include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <ostream>
+#include <sstream>
+#include <thread>
+#include <vector>
 
 #include "Common.h"
 
 #include "AbsProgramGenerator.h"
 #include "CGOptions.h"
+#include "FdOutput.h"
+#include "GenBudget.h"
+#include "Profiler.h"
 
 #include "git_version.h"
 #include "platform.h"
@@ -157,6 +167,46 @@ static void print_help() {
       << "  --output <filename> or -o <filename>: specify the output file name."
       << endl
       << endl;
+  cout << "  --output-fd <fd>: write the program to the already open file "
+          "descriptor <fd>, e.g., a pipe set up by a test harness, instead of "
+          "stdout."
+       << endl
+       << endl;
+  cout << "  --batch <count>: generate <count> programs in one run, using "
+          "consecutive seeds starting from <seed>. Unless --batch-dir is "
+          "given, all programs are written to the output file (or stdout), "
+          "each one preceded by a line "
+          "\"/*** csmith-batch seed=<seed> bytes=<size> ***/\"."
+       << endl
+       << endl;
+  cout << "  --seed-range <a>..<b>: generate one program for each seed from "
+          "<a> to <b>, as in --batch."
+       << endl
+       << endl;
+  cout << "  --batch-dir <dir>: write each program of a batch into "
+          "<dir>/csmith_<seed>.c (.cpp with --lang-cpp)."
+       << endl
+       << endl;
+  cout << "  --jobs <num>: generate the programs of a batch in <num> parallel "
+          "threads (default 1). The output does not depend on <num>."
+       << endl
+       << endl;
+  cout << "  --stats-json <file>: write timers and counters of the generation "
+          "phases (types, function bodies, fixed-point analysis, output, "
+          "...) to <file>, as one line of JSON per program."
+       << endl
+       << endl;
+  cout << "  --min-size <bytes> | --max-size <bytes>: steer the generation "
+          "towards programs of at least | at most <bytes> bytes. A program "
+          "that still ends up out of bounds is not written, and csmith "
+          "exits with status 3 (in a batch, the program is left out or "
+          "framed as \"/*** csmith-batch seed=<seed> dropped ***/\")."
+       << endl
+       << endl;
+  cout << "  --max-gen-ms <ms>: give up on a program that takes more than "
+          "<ms> milliseconds to generate, as if it were out of bounds."
+       << endl
+       << endl;
 
   // enabling/disabling options
   cout << "  --argc | --no-argc: generate main function with/without argv and "
@@ -171,10 +221,20 @@ static void print_help() {
           "structs (enabled by default)."
        << endl
        << endl;
+  cout << "  --bulk-array-hash | --no-bulk-array-hash: hash arrays of "
+          "integers, floats and padding-free structs with one call over their "
+          "memory instead of element by element (disabled by default)."
+       << endl
+       << endl;
   cout << "  --checksum | --no-checksum: enable | disable checksum calculation "
           "(enabled by default)."
        << endl
        << endl;
+  cout << "  --checksum-kind <kind>: compute the checksum with crc32 (byte at "
+          "a time, the default), slice8 (the same CRC-32, a word at a time) "
+          "or mix (a faster, table-free hash giving different checksums)."
+       << endl
+       << endl;
   cout << "  --comma-operators | --no-comma-operators: enable | disable comma "
           "operators (enabled by default)."
        << endl
@@ -321,10 +381,20 @@ static void print_help() {
           "default)."
        << endl
        << endl;
+  cout << "  --self-contained: copy the runtime headers into the program, with "
+          "only the safe math wrappers it uses, so that it compiles without "
+          "an include path (disabled by default)."
+       << endl
+       << endl;
   cout << "  --structs | --no-structs: enable | disable to generate structs "
           "(enable by default)."
        << endl
        << endl;
+  cout << "  --tailored-safe-math: write the safe math wrappers the program "
+          "uses into the program, instead of having it include all of "
+          "safe_math.h (disabled by default)."
+       << endl
+       << endl;
   cout << "  --unions | --no-unions: enable | disable to generate unions "
           "(enable by default)."
        << endl
@@ -426,6 +496,57 @@ static void print_advanced_help() {
           "(disabled by default)."
        << endl
        << endl;
+  cout << "  --dfs-shard <i>/<N>: only enumerate the share <i> of the "
+          "programs of the exhaustive mode, so that <N> processes started "
+          "with 0 <= <i> < <N> split the search between them. The search is "
+          "partitioned by the first random choices of the programs."
+       << endl
+       << endl;
+  cout << "  --dfs-shard-dir <dir>: with --dfs-shard, let a process that is "
+          "done with its own share take over the parts of the other shares "
+          "that nobody started yet. The parts are claimed through files in "
+          "<dir>, which must be shared by all the processes and empty at the "
+          "start."
+       << endl
+       << endl;
+  cout << "  --dfs-checkpoint <file>: in the exhaustive mode, save the state "
+          "of the search to <file> every --dfs-checkpoint-interval seconds, "
+          "after flushing the programs generated so far."
+       << endl
+       << endl;
+  cout << "  --dfs-checkpoint-interval <num>: seconds between two checkpoints "
+          "(default 60). 0 saves one after every program."
+       << endl
+       << endl;
+  cout << "  --dfs-resume <file>: continue the exhaustive search saved in "
+          "<file> by --dfs-checkpoint, with the same options, from the "
+          "program that follows the last one saved. Programs written after "
+          "the checkpoint are generated again."
+       << endl
+       << endl;
+  cout << "  --dfs-unique: in the exhaustive mode, skip the programs that "
+          "only differ from a program already written by the names of their "
+          "variables, functions and fields, or by their comments."
+       << endl
+       << endl;
+  cout << "  --dfs-unique-file <file>: like --dfs-unique, and also skip the "
+          "programs written by the previous runs with the same <file>, which "
+          "keeps an 8-byte fingerprint per program written."
+       << endl
+       << endl;
+  cout << "  --dfs-trace <file>: in the exhaustive mode, write the random "
+          "choices of every program written to the binary <file>, about two "
+          "bytes per choice."
+       << endl
+       << endl;
+  cout << "  --dfs-replay <file>: generate again the program of <file> "
+          "written by --dfs-trace with the same options, from its choices."
+       << endl
+       << endl;
+  cout << "  --dfs-replay-index <num>: the program of --dfs-replay, counted "
+          "from 0 (default 0)."
+       << endl
+       << endl;
   cout << "  --expand-struct: enable the expansion of struct in the exhaustive "
           "mode. ";
   cout << "Only works in the exhaustive mode and cannot used with --no-structs."
@@ -694,6 +815,168 @@ void arg_check(int argc, int i) {
   }
 }
 
+// ----------------------------------------------------------------------------
+// ----------------------------------------------------------------------------
+// Options that describe a batch (or the run) rather than a single program.
+// They are dropped from the options recorded in each generated program, so
+// that the recorded options and seed regenerate that program on their own.
+static bool is_batch_arg(const char *arg) {
+  return (strcmp(arg, "--batch") == 0 || strcmp(arg, "--seed-range") == 0 ||
+          strcmp(arg, "--batch-dir") == 0 || strcmp(arg, "--jobs") == 0 ||
+          strcmp(arg, "-j") == 0 || strcmp(arg, "--seed") == 0 ||
+          strcmp(arg, "-s") == 0 || strcmp(arg, "--output") == 0 ||
+          strcmp(arg, "-o") == 0 || strcmp(arg, "--output-fd") == 0 ||
+          strcmp(arg, "--stats-json") == 0);
+}
+
+// ----------------------------------------------------------------------------
+// Generate one program into *out or, if out is null, into the --output file
+// (or stdout). The --stats-json line of the program is stored in *stats (if
+// not null). With a size or time budget the program is built in memory and
+// is only written if it fits the budget; otherwise nothing is written and
+// false is returned.
+static bool generate_one(int argc, char **argv, unsigned long seed,
+                         std::ostream *out, string *stats) {
+  const bool budget = GenBudget::enabled();
+  std::ostringstream program;
+  AbsProgramGenerator *generator = AbsProgramGenerator::CreateInstance(
+      argc, argv, seed, budget ? &program : out);
+  if (!generator) {
+    cout << "error: can't create generator!" << std::endl;
+    exit(-1);
+  }
+  bool fits = true;
+  try {
+    generator->goGenerator();
+  } catch (const GenBudget::Exceeded &) {
+    fits = false;
+  }
+  if (stats) {
+    std::ostringstream ss;
+    Profiler::OutputJSON(ss, seed);
+    *stats = ss.str();
+  }
+  delete generator;
+  if (!budget)
+    return true;
+
+  const string text = program.str();
+  if (!fits || !GenBudget::fits(text.size()))
+    return false;
+  if (out) {
+    *out << text;
+  } else if (!CGOptions::output_file().empty()) {
+    FdOutput ofile(CGOptions::output_file());
+    ofile << text;
+  } else {
+    FdOutput ofile(CGOptions::output_fd());
+    ofile << text;
+  }
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+// Generate CGOptions::batch_count() programs in this process, with seeds
+// g_Seed, g_Seed + 1, ..., using CGOptions::jobs() threads. All the generator
+// state is thread local and is reset by Finalization::doFinalization when a
+// generator is deleted. Framed output (and the --stats-json lines, to
+// stats_out) is written in the order of the seeds, whatever the number of
+// threads. Programs that do not fit the size or time budget are left out, and
+// GenBudget::exit_code is returned if there are any.
+static int generate_batch(int argc, char **argv, std::ostream *stats_out) {
+  vector<char *> prog_argv;
+  for (int i = 0; i < argc; i++) {
+    if (i > 0 && is_batch_arg(argv[i])) {
+      i++;
+      continue;
+    }
+    prog_argv.push_back(argv[i]);
+  }
+  const int prog_argc = static_cast<int>(prog_argv.size());
+
+  const string dir = CGOptions::batch_dir();
+  std::unique_ptr<FdOutput> out;
+  if (dir.empty() && !CGOptions::output_file().empty()) {
+    out.reset(new FdOutput(CGOptions::output_file()));
+    if (!out->good()) {
+      cout << "error: can't open " << CGOptions::output_file() << std::endl;
+      return -1;
+    }
+  } else {
+    out.reset(new FdOutput(CGOptions::output_fd()));
+  }
+
+  const unsigned long count = CGOptions::batch_count();
+  std::atomic<unsigned long> next(0);
+  std::atomic<unsigned long> dropped(0);
+  std::mutex out_mutex;
+  // framed program text (unless written to dir) and stats line of each
+  // program
+  std::map<unsigned long, std::pair<string, string>> finished;
+  unsigned long next_to_write = 0;
+
+  auto worker = [&]() {
+    for (unsigned long n = next++; n < count; n = next++) {
+      const unsigned long seed = g_Seed + n;
+      std::pair<string, string> result;
+      string *stats = stats_out ? &result.second : nullptr;
+      if (!dir.empty()) {
+        std::ostringstream ss;
+        ss << dir << "/csmith_" << seed
+           << (CGOptions::lang_cpp() ? ".cpp" : ".c");
+        ofstream prog_file(ss.str().c_str());
+        if (!generate_one(prog_argc, prog_argv.data(), seed, &prog_file,
+                          stats)) {
+          prog_file.close();
+          std::remove(ss.str().c_str());
+          dropped++;
+        }
+        if (!stats)
+          continue;
+      } else {
+        std::ostringstream program;
+        std::ostringstream frame;
+        if (generate_one(prog_argc, prog_argv.data(), seed, &program,
+                         stats)) {
+          const string text = program.str();
+          frame << "/*** csmith-batch seed=" << seed
+                << " bytes=" << text.size() << " ***/" << std::endl;
+          frame << text;
+        } else {
+          frame << "/*** csmith-batch seed=" << seed << " dropped ***/"
+                << std::endl;
+          dropped++;
+        }
+        result.first = frame.str();
+      }
+
+      std::lock_guard<std::mutex> lock(out_mutex);
+      finished[n].swap(result);
+      for (auto i = finished.begin();
+           i != finished.end() && i->first == next_to_write;
+           i = finished.erase(i)) {
+        if (dir.empty())
+          *out << i->second.first;
+        if (stats_out)
+          *stats_out << i->second.second;
+        next_to_write++;
+      }
+      // whole programs only, for readers at the other end of a pipe
+      out->drain();
+      if (stats_out)
+        stats_out->flush();
+    }
+  };
+
+  vector<std::thread> threads;
+  for (int i = 1; i < CGOptions::jobs(); i++)
+    threads.emplace_back(worker);
+  worker();
+  for (auto &t : threads)
+    t.join();
+  return dropped > 0 ? GenBudget::exit_code : 0;
+}
+
 // ----------------------------------------------------------------------------
 int main(int argc, char **argv) {
   g_Seed = platform_gen_seed();
@@ -880,6 +1163,16 @@ int main(int argc, char **argv) {
       continue;
     }
 
+    if (strcmp(argv[i], "--self-contained") == 0) {
+      CGOptions::self_contained(true);
+      continue;
+    }
+
+    if (strcmp(argv[i], "--tailored-safe-math") == 0) {
+      CGOptions::tailored_safe_math(true);
+      continue;
+    }
+
     if (strcmp(argv[i], "--main") == 0) {
       CGOptions::nomain(false);
       continue;
@@ -990,6 +1283,107 @@ int main(int argc, char **argv) {
       continue;
     }
 
+    if (strcmp(argv[i], "--dfs-shard") == 0) {
+      int index = 0, count = 0;
+      i++;
+      arg_check(argc, i);
+      if (sscanf(argv[i], "%d/%d", &index, &count) != 2 || index < 0 ||
+          index >= count) {
+        cout << "please specify the shard as <i>/<N> with 0 <= i < N"
+             << std::endl;
+        exit(-1);
+      }
+      CGOptions::dfs_shard_index(index);
+      CGOptions::dfs_shard_count(count);
+      continue;
+    }
+
+    if (strcmp(argv[i], "--dfs-shard-dir") == 0) {
+      string s;
+      i++;
+      arg_check(argc, i);
+      if (!parse_string_arg(argv[i], s))
+        exit(-1);
+      CGOptions::dfs_shard_dir(s);
+      continue;
+    }
+
+    if (strcmp(argv[i], "--dfs-checkpoint") == 0) {
+      string s;
+      i++;
+      arg_check(argc, i);
+      if (!parse_string_arg(argv[i], s))
+        exit(-1);
+      CGOptions::dfs_checkpoint(s);
+      continue;
+    }
+
+    if (strcmp(argv[i], "--dfs-checkpoint-interval") == 0) {
+      unsigned long ret;
+      i++;
+      arg_check(argc, i);
+      if (!parse_int_arg(argv[i], &ret))
+        exit(-1);
+      CGOptions::dfs_checkpoint_interval(ret);
+      continue;
+    }
+
+    if (strcmp(argv[i], "--dfs-resume") == 0) {
+      string s;
+      i++;
+      arg_check(argc, i);
+      if (!parse_string_arg(argv[i], s))
+        exit(-1);
+      CGOptions::dfs_resume(s);
+      continue;
+    }
+
+    if (strcmp(argv[i], "--dfs-unique") == 0) {
+      CGOptions::dfs_unique(true);
+      continue;
+    }
+
+    if (strcmp(argv[i], "--dfs-unique-file") == 0) {
+      string s;
+      i++;
+      arg_check(argc, i);
+      if (!parse_string_arg(argv[i], s))
+        exit(-1);
+      CGOptions::dfs_unique(true);
+      CGOptions::dfs_unique_file(s);
+      continue;
+    }
+
+    if (strcmp(argv[i], "--dfs-trace") == 0) {
+      string s;
+      i++;
+      arg_check(argc, i);
+      if (!parse_string_arg(argv[i], s))
+        exit(-1);
+      CGOptions::dfs_trace(s);
+      continue;
+    }
+
+    if (strcmp(argv[i], "--dfs-replay") == 0) {
+      string s;
+      i++;
+      arg_check(argc, i);
+      if (!parse_string_arg(argv[i], s))
+        exit(-1);
+      CGOptions::dfs_replay(s);
+      continue;
+    }
+
+    if (strcmp(argv[i], "--dfs-replay-index") == 0) {
+      unsigned long ret;
+      i++;
+      arg_check(argc, i);
+      if (!parse_int_arg(argv[i], &ret))
+        exit(-1);
+      CGOptions::dfs_replay_index(ret);
+      continue;
+    }
+
     if (strcmp(argv[i], "--max-exhaustive-depth") == 0) {
       unsigned long ret;
       i++;
@@ -1010,6 +1404,94 @@ int main(int argc, char **argv) {
       continue;
     }
 
+    if (strcmp(argv[i], "--batch") == 0) {
+      unsigned long count = 0;
+      i++;
+      arg_check(argc, i);
+      if (!parse_int_arg(argv[i], &count))
+        exit(-1);
+      CGOptions::batch_count(count);
+      continue;
+    }
+
+    if (strcmp(argv[i], "--seed-range") == 0) {
+      unsigned long first = 0, last = 0;
+      i++;
+      arg_check(argc, i);
+      if (sscanf(argv[i], "%lu..%lu", &first, &last) != 2 || first > last) {
+        cout << "please specify the seed range as <a>..<b> with a <= b"
+             << std::endl;
+        exit(-1);
+      }
+      g_Seed = first;
+      CGOptions::batch_count(last - first + 1);
+      continue;
+    }
+
+    if (strcmp(argv[i], "--jobs") == 0 || strcmp(argv[i], "-j") == 0) {
+      unsigned long jobs = 0;
+      i++;
+      arg_check(argc, i);
+      if (!parse_int_arg(argv[i], &jobs))
+        exit(-1);
+      CGOptions::jobs(jobs);
+      continue;
+    }
+
+    if (strcmp(argv[i], "--batch-dir") == 0) {
+      string dir;
+      i++;
+      arg_check(argc, i);
+      if (!parse_string_arg(argv[i], dir)) {
+        cout << "please specify <dir>" << std::endl;
+        exit(-1);
+      }
+      CGOptions::batch_dir(dir);
+      continue;
+    }
+
+    if (strcmp(argv[i], "--stats-json") == 0) {
+      string stats_file;
+      i++;
+      arg_check(argc, i);
+      if (!parse_string_arg(argv[i], stats_file)) {
+        cout << "please specify <file>" << std::endl;
+        exit(-1);
+      }
+      CGOptions::stats_json(stats_file);
+      continue;
+    }
+
+    if (strcmp(argv[i], "--min-size") == 0) {
+      unsigned long size = 0;
+      i++;
+      arg_check(argc, i);
+      if (!parse_int_arg(argv[i], &size))
+        exit(-1);
+      CGOptions::min_size(size);
+      continue;
+    }
+
+    if (strcmp(argv[i], "--max-size") == 0) {
+      unsigned long size = 0;
+      i++;
+      arg_check(argc, i);
+      if (!parse_int_arg(argv[i], &size))
+        exit(-1);
+      CGOptions::max_size(size);
+      continue;
+    }
+
+    if (strcmp(argv[i], "--max-gen-ms") == 0) {
+      unsigned long ms = 0;
+      i++;
+      arg_check(argc, i);
+      if (!parse_int_arg(argv[i], &ms))
+        exit(-1);
+      CGOptions::max_gen_ms(ms);
+      continue;
+    }
+
     if (strcmp(argv[i], "--output") == 0 || strcmp(argv[i], "-o") == 0) {
       string o_file;
       i++;
@@ -1020,6 +1502,16 @@ int main(int argc, char **argv) {
       continue;
     }
 
+    if (strcmp(argv[i], "--output-fd") == 0) {
+      unsigned long fd;
+      i++;
+      arg_check(argc, i);
+      if (!parse_int_arg(argv[i], &fd))
+        exit(-1);
+      CGOptions::output_fd(fd);
+      continue;
+    }
+
     if (strcmp(argv[i], "--delta-monitor") == 0) {
       string monitor;
       i++;
@@ -1427,6 +1919,30 @@ int main(int argc, char **argv) {
       continue;
     }
 
+    if (strcmp(argv[i], "--checksum-kind") == 0) {
+      string kind;
+      i++;
+      arg_check(argc, i);
+      if (!parse_string_arg(argv[i], kind) ||
+          (kind != "crc32" && kind != "slice8" && kind != "mix")) {
+        cout << "please specify the checksum kind as crc32, slice8 or mix"
+             << std::endl;
+        exit(-1);
+      }
+      CGOptions::checksum_kind(kind);
+      continue;
+    }
+
+    if (strcmp(argv[i], "--bulk-array-hash") == 0) {
+      CGOptions::bulk_array_hash(true);
+      continue;
+    }
+
+    if (strcmp(argv[i], "--no-bulk-array-hash") == 0) {
+      CGOptions::bulk_array_hash(false);
+      continue;
+    }
+
     if (strcmp(argv[i], "--builtins") == 0) {
       CGOptions::builtins(true);
       continue;
@@ -1890,14 +2406,30 @@ int main(int argc, char **argv) {
     exit(-1);
   }
 
-  AbsProgramGenerator *generator =
-      AbsProgramGenerator::CreateInstance(argc, argv, g_Seed);
-  if (!generator) {
-    cout << "error: can't create generator!" << std::endl;
-    exit(-1);
+  ofstream stats_file;
+  if (!CGOptions::stats_json().empty()) {
+    stats_file.open(CGOptions::stats_json().c_str());
+    if (!stats_file) {
+      cout << "error: can't open " << CGOptions::stats_json() << std::endl;
+      exit(-1);
+    }
+    Profiler::enable(true);
+  }
+
+  if (CGOptions::batch_count() > 0)
+    return generate_batch(argc, argv,
+                          stats_file.is_open() ? &stats_file : nullptr);
+
+  string stats;
+  const bool fits = generate_one(argc, argv, g_Seed, nullptr,
+                                 stats_file.is_open() ? &stats : nullptr);
+  if (stats_file.is_open())
+    stats_file << stats;
+  if (!fits) {
+    cerr << "csmith: the program does not fit the size or time budget"
+         << std::endl;
+    return GenBudget::exit_code;
   }
-  generator->goGenerator();
-  delete generator;
 
   //	file.close();
   return 0;
@@ -0,0 +1,239 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2026 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <config.h>
+
+#include "ResultsDb.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+using namespace std;
+
+// bugs whose messages are closer than this (relative to the length of the
+// longer one) are taken to be the same bug
+static const double same_bug_distance = 0.2;
+
+static string escape(const string &s) {
+  string r;
+  for (char c : s) {
+    if (c == '\\')
+      r += "\\\\";
+    else if (c == '\t')
+      r += "\\t";
+    else if (c == '\n')
+      r += "\\n";
+    else
+      r += c;
+  }
+  return r;
+}
+
+static vector<string> split_record(const string &line) {
+  vector<string> fields(1);
+  for (size_t i = 0; i < line.size(); i++) {
+    const char c = line[i];
+    if (c == '\t') {
+      fields.emplace_back();
+    } else if (c == '\\' && i + 1 < line.size()) {
+      const char e = line[++i];
+      fields.back() += e == 't' ? '\t' : e == 'n' ? '\n' : e;
+    } else {
+      fields.back() += c;
+    }
+  }
+  return fields;
+}
+
+/*
+ * Levenshtein distance, as in tamer/lev.c, keeping two rows of the matrix
+ */
+static size_t lev(const string &a, const string &b) {
+  vector<size_t> prev(b.size() + 1);
+  vector<size_t> cur(b.size() + 1);
+  for (size_t j = 0; j <= b.size(); j++)
+    prev[j] = j;
+  for (size_t i = 1; i <= a.size(); i++) {
+    cur[0] = i;
+    for (size_t j = 1; j <= b.size(); j++) {
+      if (a[i - 1] == b[j - 1])
+        cur[j] = prev[j - 1];
+      else
+        cur[j] = 1 + min(min(prev[j], cur[j - 1]), prev[j - 1]);
+    }
+    prev.swap(cur);
+  }
+  return prev[b.size()];
+}
+
+// distance scaled by the longer length, as in tamer/tamer.pl
+static double distance(const string &a, const string &b) {
+  const size_t len = max(a.size(), b.size());
+  return len ? static_cast<double>(lev(a, b)) / len : 0.0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool ResultsDb::load(const string &path) {
+  ifstream in(path.c_str());
+  if (!in)
+    return false;
+  string line;
+  while (getline(in, line)) {
+    const vector<string> f = split_record(line);
+    // a record cut short by a crash is ignored
+    if (f[0] == "bug" && f.size() >= 6) {
+      BugRecord b;
+      b.seed = f[1];
+      b.kind = f[2];
+      b.signature = f[3];
+      b.message = f[4];
+      b.file = f[5];
+      classify(b);
+    }
+  }
+  return true;
+}
+
+bool ResultsDb::open(const string &path) {
+  load(path);
+  out_.open(path.c_str(), ios::app);
+  return out_.good();
+}
+
+void ResultsDb::add_run(const RunRecord &r) {
+  out_ << "run\t" << escape(r.seed) << "\t" << escape(r.options) << "\t"
+       << escape(r.compiler) << "\t" << r.result << "\t" << r.compiler_exit
+       << "\t" << r.program_exit << "\t" << escape(r.checksum) << "\t"
+       << r.compile_ms << "\t" << r.run_ms << "\n";
+  out_.flush();
+}
+
+size_t ResultsDb::find_cluster(const BugRecord &b) const {
+  size_t best = npos;
+  double best_dist = same_bug_distance;
+  for (size_t i = 0; i < clusters_.size(); i++) {
+    const BugCluster &c = clusters_[i];
+    if (c.kind != b.kind || c.signature != b.signature)
+      continue;
+    const double d = distance(c.message, b.message);
+    if (d <= best_dist) {
+      best = i;
+      best_dist = d;
+    }
+  }
+  return best;
+}
+
+size_t ResultsDb::classify(const BugRecord &b) {
+  size_t i = find_cluster(b);
+  if (i == npos) {
+    i = clusters_.size();
+    clusters_.emplace_back();
+    BugCluster &c = clusters_.back();
+    c.kind = b.kind;
+    c.signature = b.signature;
+    c.message = b.message;
+    c.first_seed = b.seed;
+    c.first_file = b.file;
+  }
+  clusters_[i].hits++;
+  return i;
+}
+
+size_t ResultsDb::add_bug(const BugRecord &b) {
+  const size_t i = classify(b);
+  out_ << "bug\t" << escape(b.seed) << "\t" << b.kind << "\t"
+       << escape(b.signature) << "\t" << escape(b.message) << "\t"
+       << escape(b.file) << "\t" << i << "\n";
+  out_.flush();
+  return i;
+}
+
+/*
+ * Farthest-first order, like tamer/tamer.pl and tamer/gonzalez.c: start with
+ * the cluster with the most hits, then take the cluster farthest from all the
+ * ones listed so far
+ */
+void ResultsDb::OutputTriage(std::ostream &out) const {
+  const size_t n = clusters_.size();
+  vector<string> keys;
+  for (const BugCluster &c : clusters_)
+    keys.push_back(c.signature + " " + c.message);
+  // distance of each cluster to the nearest one listed
+  vector<double> nearest(n, 2.0);
+  vector<bool> listed(n, false);
+
+  out << n << " distinct bugs" << endl;
+  for (size_t k = 0; k < n; k++) {
+    size_t pick = npos;
+    for (size_t i = 0; i < n; i++) {
+      if (listed[i])
+        continue;
+      if (pick == npos || nearest[i] > nearest[pick] ||
+          (nearest[i] == nearest[pick] &&
+           clusters_[i].hits > clusters_[pick].hits))
+        pick = i;
+    }
+    listed[pick] = true;
+    const BugCluster &c = clusters_[pick];
+    out << "------------------------------------------------------------------"
+        << endl;
+    out << "cluster " << pick << ": " << c.kind << ", " << c.hits
+        << (c.hits == 1 ? " hit" : " hits");
+    if (k > 0)
+      out << ", distance " << fixed << setprecision(3) << nearest[pick];
+    out << endl;
+    out << "  compilers: " << c.signature << endl;
+    if (!c.message.empty())
+      out << "  message: " << c.message << endl;
+    out << "  first seen: seed " << c.first_seed;
+    if (!c.first_file.empty())
+      out << " (" << c.first_file << ")";
+    out << endl;
+
+    for (size_t i = 0; i < n; i++) {
+      if (listed[i])
+        continue;
+      const double d = clusters_[i].kind == c.kind
+                           ? distance(keys[i], keys[pick])
+                           : 1.0;
+      nearest[i] = min(nearest[i], d);
+    }
+  }
+}
+
+// Local Variables:
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+
+// End of file.
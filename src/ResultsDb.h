@@ -0,0 +1,127 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2026 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef RESULTS_DB_H
+#define RESULTS_DB_H
+
+///////////////////////////////////////////////////////////////////////////////
+
+#include <fstream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/*
+ * What happened to one test program with one compiler
+ */
+struct RunRecord {
+  std::string seed;
+  std::string options;
+  std::string compiler;
+  std::string result; // normal, compiler-crash, program-hang, ...
+  int compiler_exit = -1;
+  int program_exit = -1;
+  std::string checksum;
+  long compile_ms = 0;
+  long run_ms = 0;
+};
+
+/*
+ * A divergence found by a test. The signature names the compilers involved
+ * (for wrong code, how they split on the checksum) and the message is the
+ * normalized diagnostic of a crash.
+ */
+struct BugRecord {
+  std::string seed;
+  std::string kind; // compiler-crash, compiler-hang, program-crash, wrong-code
+  std::string signature;
+  std::string message;
+  std::string file; // where the test program was saved, if it was
+};
+
+/*
+ * Bugs of the same kind and signature whose messages are close in
+ * Levenshtein distance, as in tamer/
+ */
+struct BugCluster {
+  std::string kind;
+  std::string signature;
+  std::string message;
+  std::string first_seed;
+  std::string first_file;
+  unsigned long hits = 0;
+};
+
+/*
+ * The results database of csmith_test: an append-only file of tab-separated
+ * records, one per test and compiler ("run") and one per divergence ("bug").
+ * The bug clusters are rebuilt from the bug records when the file is opened.
+ */
+class ResultsDb {
+public:
+  static const size_t npos = static_cast<size_t>(-1);
+
+  // load the records of path, if it exists, and open it for appending
+  bool open(const std::string &path);
+
+  // only load the records of path
+  bool load(const std::string &path);
+
+  void add_run(const RunRecord &r);
+
+  // the cluster a bug would join, or npos for a new bug
+  size_t find_cluster(const BugRecord &b) const;
+
+  // record the bug and return its cluster
+  size_t add_bug(const BugRecord &b);
+
+  size_t cluster_count(void) const { return clusters_.size(); }
+  const BugCluster &cluster(size_t i) const { return clusters_[i]; }
+
+  // list the clusters, most different ones first
+  void OutputTriage(std::ostream &out) const;
+
+private:
+  size_t classify(const BugRecord &b);
+
+  std::vector<BugCluster> clusters_;
+  std::ofstream out_;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // RESULTS_DB_H
+
+// Local Variables:
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+
+// End of file.
@@ -0,0 +1,159 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2026 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <config.h>
+
+#include "RuntimePrelude.h"
+
+#include <algorithm>
+#include <sstream>
+#include <vector>
+
+#include "SafeOpFlags.h"
+
+using namespace std;
+
+const char *RuntimePrelude::find_header(const string &name) {
+  for (const RuntimeHeader *h = headers_; h->name; h++) {
+    if (name == h->name)
+      return h->text;
+  }
+  return nullptr;
+}
+
+// the file name of an #include "..." line
+static bool quoted_include(const string &line, string &name) {
+  size_t pos = line.find_first_not_of(" \t");
+  if (pos == string::npos || line.compare(pos, 8, "#include") != 0)
+    return false;
+  pos = line.find_first_not_of(" \t", pos + 8);
+  if (pos == string::npos || line[pos] != '"')
+    return false;
+  const size_t end = line.find('"', pos + 1);
+  if (end == string::npos)
+    return false;
+  name = line.substr(pos + 1, end - pos - 1);
+  return true;
+}
+
+void RuntimePrelude::expand(ostream &out, const string &text,
+                            set<string> &done) {
+  istringstream in(text);
+  string line;
+  string name;
+  while (getline(in, line)) {
+    const char *header = nullptr;
+    if (quoted_include(line, name) && (header = find_header(name))) {
+      // all the runtime headers have include guards
+      if (done.insert(name).second) {
+        out << "/* ---- " << name << " ---- */\n";
+        expand(out, name == "safe_math.h" ? UsedSafeMath(header) : header,
+               done);
+        out << "/* ---- end of " << name << " ---- */\n";
+      }
+      continue;
+    }
+    out << line << '\n';
+  }
+}
+
+void RuntimePrelude::Expand(ostream &out, const string &program) {
+  set<string> done;
+  expand(out, program, done);
+}
+
+void RuntimePrelude::InsertSafeMath(ostream &out, const string &program) {
+  istringstream in(program);
+  string line;
+  string name;
+  bool inserted = false;
+  while (getline(in, line)) {
+    out << line << '\n';
+    if (!inserted && quoted_include(line, name) && name == "csmith.h") {
+      // random_inc.h skips safe_math.h when CSMITH_TAILORED_SAFE_MATH is set
+      out << "\n#define FUNC_NAME(x) (safe_##x)\n"
+          << UsedSafeMath(find_header("safe_math.h")) << "#undef FUNC_NAME\n";
+      inserted = true;
+    }
+  }
+}
+
+/*
+ * Every wrapper in safe_math.h is a "STATIC <type>" line, a
+ * "FUNC_NAME(<name>)(...)" line and a body ending with a "}" line. Drop those
+ * not in SafeOpFlags::wrapper_names, and keep everything else.
+ */
+string RuntimePrelude::UsedSafeMath(const string &safe_math) {
+  const vector<string> &used = SafeOpFlags::wrapper_names;
+  istringstream in(safe_math);
+  ostringstream out;
+  string line;
+  string static_line;
+  bool skipping = false;
+  bool after_skipped = false;
+  while (getline(in, line)) {
+    if (skipping) {
+      skipping = line != "}";
+      after_skipped = !skipping;
+      continue;
+    }
+    if (after_skipped && line.empty())
+      continue;
+    after_skipped = false;
+    if (line.compare(0, 7, "STATIC ") == 0) {
+      static_line = line;
+      continue;
+    }
+    if (!static_line.empty()) {
+      const size_t open = line.find('(');
+      const size_t close = line.find(')');
+      if (line.compare(0, 10, "FUNC_NAME(") == 0 && close != string::npos) {
+        const string fname =
+            "safe_" + line.substr(open + 1, close - open - 1);
+        if (std::find(used.begin(), used.end(), fname) == used.end()) {
+          static_line.clear();
+          skipping = true;
+          continue;
+        }
+      }
+      out << static_line << '\n';
+      static_line.clear();
+    }
+    out << line << '\n';
+  }
+  return out.str();
+}
+
+// Local Variables:
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+
+// End of file.
@@ -0,0 +1,88 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2026 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef RUNTIME_PRELUDE_H
+#define RUNTIME_PRELUDE_H
+
+///////////////////////////////////////////////////////////////////////////////
+
+#include <ostream>
+#include <set>
+#include <string>
+
+struct RuntimeHeader {
+  const char *name;
+  const char *text;
+};
+
+/*
+ * The runtime headers compiled into csmith (see
+ * cmake/EmbedRuntimeHeaders.cmake), used to write programs that need no
+ * include path (--self-contained) or that define only the safe math wrappers
+ * they use (--tailored-safe-math). Only the headers that a hosted program
+ * includes by default are embedded; the includes of the others stay in their
+ * #if branches.
+ */
+class RuntimePrelude {
+public:
+  // write program with each #include "..." of an embedded header replaced by
+  // the header itself, once
+  static void Expand(std::ostream &out, const std::string &program);
+
+  // write program with the safe math wrappers it uses defined right after its
+  // #include "csmith.h" (--tailored-safe-math)
+  static void InsertSafeMath(std::ostream &out, const std::string &program);
+
+  // the safe math wrappers of safe_math.h that the current program uses
+  static std::string UsedSafeMath(const std::string &safe_math);
+
+private:
+  RuntimePrelude();
+  ~RuntimePrelude();
+
+  static const char *find_header(const std::string &name);
+
+  static void expand(std::ostream &out, const std::string &text,
+                     std::set<std::string> &done);
+
+  // generated, ends with {nullptr, nullptr}
+  static const RuntimeHeader headers_[];
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // RUNTIME_PRELUDE_H
+
+// Local Variables:
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+
+// End of file.
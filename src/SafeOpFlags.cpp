@@ -43,7 +43,9 @@
 
 using namespace std;
 
-vector<string> SafeOpFlags::wrapper_names;
+thread_local vector<string> SafeOpFlags::wrapper_names;
+
+void SafeOpFlags::doFinalization() { wrapper_names.clear(); }
 
 SafeOpFlags::SafeOpFlags() {
   // Nothing to do
@@ -91,9 +91,11 @@ public:
   std::string to_string(eUnaryOps op) const;
   static int to_id(const std::string &fname);
 
+  static void doFinalization();
+
   ~SafeOpFlags();
 
-  static std::vector<std::string> wrapper_names;
+  static thread_local std::vector<std::string> wrapper_names;
 
 private:
   bool op1_;
@@ -53,6 +53,9 @@ public:
 
   virtual int get_number_by_pos(int pos) = 0;
 
+  // The bound of the choice at `pos', 0 when it is unknown.
+  virtual int get_bound_by_pos(int pos) = 0;
+
   virtual void clear() = 0;
 
   virtual void get_sequence(std::ostream &out) = 0;
@@ -36,9 +36,9 @@
 #include <iostream>
 #include <string>
 
-std::set<Sequence *> SequenceFactory::seqs_;
+thread_local std::set<Sequence *> SequenceFactory::seqs_;
 
-char SequenceFactory::current_sep_char_ = '_';
+thread_local char SequenceFactory::current_sep_char_ = '_';
 
 Sequence *SequenceFactory::make_sequence() {
   Sequence *seq = nullptr;
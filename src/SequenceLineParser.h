@@ -30,9 +30,9 @@
 #ifndef SEQUENCE_LINE_PARSER_H
 #define SEQUENCE_LINE_PARSER_H
 
-#include "StdLibAliases.h"
-#include <iostream>
-#include <sstream>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
 #include <string>
 template <class Container> class SequenceLineParser {
 public:
@@ -42,9 +42,6 @@ public:
 
   static bool parse_sequence(Container &q, const std::string &seq,
                              const char sep_char = ',');
-
-private:
-  static int str2int(const std::string &s);
 };
 
 template <class Container>
@@ -53,37 +50,25 @@ SequenceLineParser<Container>::SequenceLineParser() {}
 template <class Container>
 SequenceLineParser<Container>::~SequenceLineParser() {}
 
+/*
+ * Parse the numbers in place, a sequence can hold millions of them.
+ */
 template <class Container>
 bool SequenceLineParser<Container>::parse_sequence(Container &q,
                                                    const std::string &seq,
                                                    const char sep_char) {
-  // while (pos < static_cast<int>(seq.size())) {
-  for (size_t pos = 0; true;) {
-    size_t start_pos = 0;
-    while (seq[pos] == ' ')
-      pos++;
-
-    start_pos = pos;
-    pos = seq.find_first_of(sep_char, pos);
-    std::string s = seq.substr(start_pos, (pos - start_pos));
-    int i = SequenceLineParser::str2int(s);
-    if (i < 0)
+  for (const char *p = seq.c_str(); true;) {
+    char *end = nullptr;
+    long i = strtol(p, &end, 10);
+    if (end == p || i < 0 || i > INT_MAX)
       return false;
-    q.push_back(i);
-    if (pos == string::npos)
+    q.push_back(static_cast<int>(i));
+    p = strchr(end, sep_char);
+    if (p == nullptr)
       break;
-    pos++;
+    p++;
   }
   return true;
 }
 
-template <class Container>
-int SequenceLineParser<Container>::str2int(const std::string &s) {
-  stringstream ss(s);
-  int i = -1;
-  ss >> i;
-
-  return i;
-}
-
 #endif // SEQUENCE_PARSER_H
@@ -0,0 +1,193 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2026 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include <config.h>
+
+#include "SequenceTrace.h"
+
+#include "Sequence.h"
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
+#ifndef WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+const char SequenceTrace::magic[8] = {'C', 'S', 'T', 'R', 'A', 'C', 'E', '1'};
+
+static void put_varint(std::string &buf, uint64_t v) {
+  while (v >= 0x80) {
+    buf += static_cast<char>((v & 0x7f) | 0x80);
+    v >>= 7;
+  }
+  buf += static_cast<char>(v);
+}
+
+static bool get_varint(const unsigned char *&p, const unsigned char *end,
+                       uint64_t &v) {
+  v = 0;
+  for (int shift = 0; p < end && shift < 64; shift += 7) {
+    const unsigned char c = *p++;
+    v |= static_cast<uint64_t>(c & 0x7f) << shift;
+    if (!(c & 0x80))
+      return true;
+  }
+  return false;
+}
+
+void SequenceTrace::write_header(std::ostream &out) {
+  out.write(magic, sizeof(magic));
+}
+
+size_t SequenceTrace::write(std::ostream &out, unsigned flags,
+                            uint64_t rand_state, Sequence &seq) {
+  std::string body;
+  const int n = static_cast<int>(seq.sequence_length());
+  put_varint(body, flags);
+  put_varint(body, rand_state);
+  put_varint(body, n);
+  for (int i = 0; i < n; ++i) {
+    put_varint(body, seq.get_number_by_pos(i));
+    put_varint(body, seq.get_bound_by_pos(i));
+  }
+  std::string size;
+  put_varint(size, body.size());
+  out.write(size.data(), size.size());
+  out.write(body.data(), body.size());
+  return size.size() + body.size();
+}
+
+/*
+ * The contents of a file, mapped in memory where the platform allows it so
+ * that the records before the one wanted are never copied.
+ */
+class MappedFile {
+public:
+  explicit MappedFile(const std::string &path);
+
+  ~MappedFile();
+
+  const unsigned char *data() const { return data_; }
+
+  size_t size() const { return size_; }
+
+private:
+  const unsigned char *data_;
+
+  size_t size_;
+
+#ifdef WIN32
+  std::vector<char> buf_;
+#else
+  void *map_;
+#endif
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+};
+
+#ifdef WIN32
+MappedFile::MappedFile(const std::string &path) : data_(nullptr), size_(0) {
+  ifstream in(path.c_str(), ios::binary);
+  buf_.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+  data_ = reinterpret_cast<const unsigned char *>(buf_.data());
+  size_ = buf_.size();
+}
+
+MappedFile::~MappedFile() {}
+#else
+MappedFile::MappedFile(const std::string &path)
+    : data_(nullptr), size_(0), map_(MAP_FAILED) {
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+    return;
+  struct stat st;
+  if (fstat(fd, &st) == 0 && st.st_size > 0) {
+    map_ = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (map_ != MAP_FAILED) {
+      data_ = static_cast<const unsigned char *>(map_);
+      size_ = st.st_size;
+    }
+  }
+  close(fd);
+}
+
+MappedFile::~MappedFile() {
+  if (map_ != MAP_FAILED)
+    munmap(map_, size_);
+}
+#endif
+
+bool SequenceTrace::read(const std::string &path, size_t index,
+                         unsigned &flags, uint64_t &rand_state,
+                         Sequence &seq) {
+  MappedFile file(path);
+  if (file.size() < sizeof(magic) ||
+      memcmp(file.data(), magic, sizeof(magic)) != 0)
+    return false;
+  const unsigned char *p = file.data() + sizeof(magic);
+  const unsigned char *end = file.data() + file.size();
+  uint64_t size = 0;
+  for (size_t i = 0; i < index; ++i) {
+    if (!get_varint(p, end, size) || size > static_cast<size_t>(end - p))
+      return false;
+    p += size;
+  }
+  if (!get_varint(p, end, size) || size > static_cast<size_t>(end - p))
+    return false;
+  end = p + size;
+  uint64_t v = 0, n = 0;
+  if (!get_varint(p, end, v))
+    return false;
+  flags = static_cast<unsigned>(v);
+  if (!get_varint(p, end, rand_state) || !get_varint(p, end, n))
+    return false;
+  seq.clear();
+  for (uint64_t i = 0; i < n; ++i) {
+    uint64_t value = 0, bound = 0;
+    if (!get_varint(p, end, value) || !get_varint(p, end, bound))
+      return false;
+    seq.add_number(static_cast<int>(value), static_cast<int>(bound),
+                   static_cast<int>(i));
+  }
+  return true;
+}
+
+// Local Variables:
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+
+// End of file.
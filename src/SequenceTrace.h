@@ -0,0 +1,76 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2026 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef SEQUENCE_TRACE_H
+#define SEQUENCE_TRACE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+class Sequence;
+
+/*
+ * The binary file of sequences of random choices written by --dfs-trace and
+ * read by --dfs-replay. The file starts with `magic', followed by one record
+ * per program: the size in bytes of the rest of the record, its flags, the
+ * state of genrand when the program started, the number of choices and then
+ * the value and the bound of every choice. All of them are unsigned LEB128
+ * varints, so a choice usually takes two bytes, and a reader gets to a record
+ * by skipping the ones before it without decoding them.
+ */
+class SequenceTrace {
+public:
+  static const char magic[8];
+
+  // The program created the generator behind pure_rnd_*, which seeds
+  // genrand, so the state of genrand only applies before it does.
+  static const unsigned seeds_rand = 1;
+
+  static void write_header(std::ostream &out);
+
+  // Append a record of `seq' to `out' and return its size in bytes.
+  static size_t write(std::ostream &out, unsigned flags, uint64_t rand_state,
+                      Sequence &seq);
+
+  // Add the choices of record `index' of the file `path' to `seq'. Return
+  // false if the file is not a trace or has no such record.
+  static bool read(const std::string &path, size_t index, unsigned &flags,
+                   uint64_t &rand_state, Sequence &seq);
+};
+
+#endif // SEQUENCE_TRACE_H
+
+// Local Variables:
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+
+// End of file.
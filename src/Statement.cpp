@@ -65,8 +65,10 @@
 #include "Error.h"
 #include "Fact.h"
 #include "FactMgr.h"
+#include "GenBudget.h"
 #include "OutputMgr.h"
 #include "PartialExpander.h"
+#include "Profiler.h"
 #include "ProbabilityTable.h"
 #include "StatementArrayOp.h"
 #include "StatementAssign.h" // temporary; don't want to depend on subclases!
@@ -85,9 +87,9 @@
 #include "util.h"
 
 using namespace std;
-const Statement *Statement::failed_stm;
+thread_local const Statement *Statement::failed_stm;
 
-AttributeGenerator Statement::label_attr_generator;
+thread_local AttributeGenerator Statement::label_attr_generator;
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -108,7 +110,7 @@ public:
 
   virtual bool filter(int v) const;
 
-  static bool label_attr_generate;
+  static thread_local bool label_attr_generate;
 
 private:
   const CGContext &cg_context_;
@@ -124,11 +126,12 @@ StatementFilter::StatementFilter(const CGContext &cg_context)
 
 StatementFilter::~StatementFilter(void) {}
 
-bool StatementFilter::label_attr_generate = false;
+thread_local bool StatementFilter::label_attr_generate = false;
 
 // use a table to define probabilities of different kinds of statements
 // Must initialize it before use
-ProbabilityTable<unsigned int, ProbName> *Statement::stmtTable_ = nullptr;
+thread_local ProbabilityTable<unsigned int, ProbName> *Statement::stmtTable_ =
+    nullptr;
 
 void Statement::InitProbabilityTable() {
   if (Statement::stmtTable_)
@@ -138,6 +141,18 @@ void Statement::InitProbabilityTable() {
   Statement::stmtTable_->initialize(ProbName::pStatementProb);
 }
 
+/*
+ * Reset statement ids, the statement table and label attributes
+ */
+void Statement::doFinalization() {
+  sid = 0;
+  failed_stm = nullptr;
+  delete Statement::stmtTable_;
+  Statement::stmtTable_ = nullptr;
+  Statement::label_attr_generator.clear();
+  StatementFilter::label_attr_generate = false;
+}
+
 eStatementType Statement::number_to_type(unsigned int value) {
   assert(Statement::stmtTable_);
   assert(value < 100);
@@ -169,6 +184,10 @@ bool StatementFilter::filter(int value) const {
   if ((type == eStatementType::eReturn) && no_return) {
     return true;
   }
+  // don't end blocks early until the program reaches --min-size
+  if ((type == eStatementType::eReturn) && GenBudget::below_min_size()) {
+    return true;
+  }
 
   if ((type == eStatementType::eBreak || type == eStatementType::eContinue) && !(cg_context_.flags & IN_LOOP)) {
     return true;
@@ -235,7 +254,7 @@ static eStatementType StatementProbability(const StatementFilter *filter) {
   return Statement::number_to_type(value);
 }
 
-int Statement::sid = 0;
+thread_local int Statement::sid = 0;
 /*
  *
  */
@@ -245,6 +264,7 @@ Statement *Statement::make_random(CGContext &cg_context, eStatementType t) {
   // Should initialize table first
   Statement::InitProbabilityTable();
 
+  GenBudget::check_time();
   if ((CGOptions::stop_by_stmt() >= 0) && (sid >= CGOptions::stop_by_stmt())) {
     t = eStatementType::eReturn;
   }
@@ -362,7 +382,7 @@ bool Statement::is_ptr_used(void) const {
  *
  */
 Statement::Statement(eStatementType st, Block *b)
-    : eType(st), func(b ? b->func : 0), parent(b) {
+    : eType(st), fact_slot(-1), func(b ? b->func : 0), parent(b) {
   stm_id = Statement::sid;
   Statement::sid++;
 }
@@ -554,13 +574,16 @@ int Statement::shortcut_analysis(vector<const Fact *> &inputs,
     // print_facts(inputs);
     // fm->map_stm_effect[this].Output(cout);
     if (cg_context.in_conflict(fm->map_stm_effect[this])) {
+      Profiler::incr(eProfCounter::eShortcutConflicts);
       return 1;
     }
     inputs = fm->map_facts_out[this];
     cg_context.add_effect(fm->map_stm_effect[this]);
     fm->map_accum_effect[this] = *(cg_context.get_effect_accum());
+    Profiler::incr(eProfCounter::eShortcutHits);
     return 0;
   }
+  Profiler::incr(eProfCounter::eShortcutMisses);
   return 2;
 }
 
@@ -39,6 +39,7 @@
 #ifdef WIN32
 #pragma warning(disable : 4786) /* Disable annoying warning messages */
 #endif
+#include "NodePool.h"
 #include "Probabilities.h"
 #include "StdLibAliases.h"
 #include <ostream>
@@ -97,6 +98,12 @@ public:
 
   virtual ~Statement(void);
 
+  // nodes live in the NodePool of the generating thread
+  static void *operator new(size_t size) { return NodePool::allocate(size); }
+  static void operator delete(void *p, size_t size) {
+    NodePool::deallocate(p, size);
+  }
+
   eStatementType get_type(void) const { return eType; }
 
   std::string to_string(void) const {
@@ -207,23 +214,28 @@ public:
 
   static int get_current_sid(void) { return sid; }
 
+  static void doFinalization();
+
   int get_blk_depth(void) const;
 
-  static AttributeGenerator label_attr_generator;
+  static thread_local AttributeGenerator label_attr_generator;
 
   // unique id for each statement
   int stm_id;
+  // index into the per-statement tables of the function's FactMgr, -1 until
+  // the statement is first looked up there
+  mutable int fact_slot;
   Function *func;
   Block *parent;
-  static const Statement *failed_stm;
+  static thread_local const Statement *failed_stm;
 
-  static ProbabilityTable<unsigned int, ProbName> *stmtTable_;
+  static thread_local ProbabilityTable<unsigned int, ProbName> *stmtTable_;
 
 protected:
   Statement(eStatementType st, Block *parent);
 
 private:
-  static int sid;
+  static thread_local int sid;
 
   Statement &operator=(const Statement &s) = delete;
 
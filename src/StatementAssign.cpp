@@ -63,7 +63,7 @@ using namespace std;
 //
 // use a table to define probabilities of different kinds of statements
 // Must initialize it before use
-DistributionTable StatementAssign::assignOpsTable_;
+thread_local DistributionTable StatementAssign::assignOpsTable_;
 
 void StatementAssign::InitProbabilityTable() {
   assignOpsTable_.add_entry((int)eAssignOps::eSimpleAssign, 70);
@@ -81,6 +81,8 @@ void StatementAssign::InitProbabilityTable() {
   }
 }
 
+void StatementAssign::doFinalization() { assignOpsTable_.clear(); }
+
 eAssignOps StatementAssign::AssignOpsProbability(const Type *type) {
   if (!CGOptions::compound_assignment()) {
     return eAssignOps::eSimpleAssign;
@@ -102,6 +104,7 @@ eAssignOps StatementAssign::AssignOpsProbability(const Type *type) {
   }
 
   int value = rnd_upto(filter.get_max_prob(), &filter);
+  ERROR_GUARD(MAX_ASSIGN_OP);
   return (eAssignOps)(filter.lookup(value));
 }
 
@@ -113,6 +116,7 @@ StatementAssign *StatementAssign::make_random(CGContext &cg_context,
                                               const CVQualifiers *qf) {
   // decide assignment operator
   eAssignOps op = AssignOpsProbability(type);
+  ERROR_GUARD(nullptr);
   // bool stand_alone_assign = false;
 
   // decide type
@@ -120,6 +124,7 @@ StatementAssign *StatementAssign::make_random(CGContext &cg_context,
     // stand_alone_assign = true;
     type = Type::SelectLType(
         !cg_context.get_effect_context().is_side_effect_free(), op);
+    ERROR_GUARD(nullptr);
   }
   assert(!type->is_const_struct_union());
 
@@ -186,11 +191,10 @@ StatementAssign *StatementAssign::make_random(CGContext &cg_context,
   lhs_cg_context.get_effect_stm() = rhs_cg_context.get_effect_stm();
   lhs_cg_context.curr_rhs = e;
 
-  bool prev_flag =
-      CGOptions::match_exact_qualifiers(); // keep a copy of previous flag
+  bool prev_flag = CVQualifiers::force_exact_match; // keep a copy
   if (qf)
-    CGOptions::match_exact_qualifiers(
-        true); // force exact qualifier match when selecting vars
+    CVQualifiers::force_exact_match =
+        true; // force exact qualifier match when selecting vars
   if (CGOptions::strict_float()) {
     lhs = Lhs::make_random(lhs_cg_context, &e->get_type(), &qfer,
                            op != eAssignOps::eSimpleAssign, need_no_rhs(op));
@@ -200,7 +204,7 @@ StatementAssign *StatementAssign::make_random(CGContext &cg_context,
   }
 
   if (qf)
-    CGOptions::match_exact_qualifiers(prev_flag); // restore flag
+    CVQualifiers::force_exact_match = prev_flag; // restore flag
   ERROR_GUARD_AND_DEL2(nullptr, e, lhs);
 
   // typecast, if needed.
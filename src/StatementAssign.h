@@ -97,6 +97,7 @@ public:
                   std::string &tmp_name1, std::string &tmp_name2);
 
   static void InitProbabilityTable();
+  static void doFinalization();
   static bool safe_assign(eAssignOps op);
   static bool need_no_rhs(eAssignOps op) {
     return op == eAssignOps::ePreIncr || op == eAssignOps::ePreDecr ||
@@ -154,7 +155,7 @@ private:
   std::string tmp_var1;
   std::string tmp_var2;
 
-  static DistributionTable assignOpsTable_;
+  static thread_local DistributionTable assignOpsTable_;
 
   StatementAssign(const StatementAssign &sa); // unimplemented
 
@@ -314,12 +314,15 @@ StatementFor *
 StatementFor::make_random_array_loop(const CGContext &cg_context) {
   // select the number of arrays to manipulate, default maximum = 4;
   unsigned int aryno = rnd_upto(CGOptions::max_array_num_in_loop());
+  ERROR_GUARD(nullptr);
   // choose arrays to manipulate, create new ones if necessary
   VariableSet must_reads, must_writes;
   for (size_t i = 0; i < aryno; i++) {
     const ArrayVariable *av = VariableSelector::select_array(cg_context);
+    ERROR_GUARD(nullptr);
     // random access choice: 0 = must read, 1 = must write, 2 = both
     int access = rnd_upto(3);
+    ERROR_GUARD(nullptr);
     if (access == 0 || access == 2) {
       add_variable_to_set(must_reads, static_cast<const Variable *>(av));
     }
@@ -76,7 +76,7 @@ public:
   const Statement *dest;
   std::string label;
   std::vector<const Variable *> init_skipped_vars;
-  static std::map<const Statement *, std::string> stm_labels;
+  static thread_local std::map<const Statement *, std::string> stm_labels;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,124 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2026 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <config.h>
+
+#include "TaskPool.h"
+
+#include <cassert>
+#include <thread>
+
+using namespace std;
+
+thread_local int TaskPool::self_ = -1;
+
+TaskPool::TaskPool(unsigned workers)
+    : queued_(0), pending_(0), next_queue_(0) {
+  assert(workers > 0);
+  for (unsigned i = 0; i < workers; i++)
+    queues_.emplace_back(new Queue);
+}
+
+TaskPool::~TaskPool(void) { assert(pending_ == 0); }
+
+void TaskPool::submit(Task task) {
+  unsigned q;
+  {
+    lock_guard<mutex> lock(idle_mutex_);
+    q = self_ >= 0 ? static_cast<unsigned>(self_)
+                   : next_queue_++ % queues_.size();
+  }
+  {
+    lock_guard<mutex> lock(queues_[q]->mutex);
+    queues_[q]->tasks.push_back(std::move(task));
+  }
+  {
+    lock_guard<mutex> lock(idle_mutex_);
+    queued_++;
+    pending_++;
+  }
+  idle_.notify_one();
+}
+
+bool TaskPool::take(unsigned self, Task &task) {
+  const unsigned n = static_cast<unsigned>(queues_.size());
+  for (unsigned i = 0; i < n; i++) {
+    Queue &q = *queues_[(self + i) % n];
+    lock_guard<mutex> lock(q.mutex);
+    if (q.tasks.empty())
+      continue;
+    if (i == 0) {
+      task = std::move(q.tasks.back());
+      q.tasks.pop_back();
+    } else {
+      task = std::move(q.tasks.front());
+      q.tasks.pop_front();
+    }
+    lock_guard<mutex> idle_lock(idle_mutex_);
+    queued_--;
+    return true;
+  }
+  return false;
+}
+
+void TaskPool::work(unsigned self) {
+  self_ = static_cast<int>(self);
+  for (;;) {
+    Task task;
+    if (take(self, task)) {
+      task();
+      lock_guard<mutex> lock(idle_mutex_);
+      if (--pending_ == 0)
+        idle_.notify_all();
+      continue;
+    }
+    unique_lock<mutex> lock(idle_mutex_);
+    if (pending_ == 0)
+      break;
+    idle_.wait(lock, [this] { return queued_ > 0 || pending_ == 0; });
+  }
+  self_ = -1;
+}
+
+void TaskPool::run(void) {
+  vector<thread> threads;
+  for (unsigned i = 1; i < queues_.size(); i++)
+    threads.emplace_back(&TaskPool::work, this, i);
+  work(0);
+  for (auto &t : threads)
+    t.join();
+}
+
+// Local Variables:
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+
+// End of file.
@@ -0,0 +1,95 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2026 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef TASK_POOL_H
+#define TASK_POOL_H
+
+///////////////////////////////////////////////////////////////////////////////
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/*
+ * A fixed set of worker threads with one task deque each. A task submitted
+ * from a worker goes to the back of that worker's deque, and workers take
+ * their own newest task first, so the follow-up steps of a job stay on the
+ * thread that started it. An idle worker steals the oldest task of another
+ * worker. Tasks may submit more tasks; run() returns once none is left.
+ */
+class TaskPool {
+public:
+  typedef std::function<void(void)> Task;
+
+  explicit TaskPool(unsigned workers);
+  ~TaskPool(void);
+
+  void submit(Task task);
+
+  // run the tasks on the calling thread and workers - 1 others
+  void run(void);
+
+private:
+  struct Queue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  bool take(unsigned self, Task &task);
+  void work(unsigned self);
+
+  std::vector<std::unique_ptr<Queue>> queues_;
+
+  // counts of the tasks in the queues, and of those not yet finished
+  std::mutex idle_mutex_;
+  std::condition_variable idle_;
+  size_t queued_;
+  size_t pending_;
+
+  // round robin over the queues for tasks submitted from outside the pool
+  unsigned next_queue_;
+
+  // index of the worker running on this thread, or -1
+  static thread_local int self_;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // TASK_POOL_H
+
+// Local Variables:
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+
+// End of file.
@@ -47,6 +47,7 @@
 #include "Error.h"
 #include "Filter.h"
 #include "Probabilities.h"
+#include "Profiler.h"
 #include "Type.h"
 #include "random.h"
 #include "util.h"
@@ -61,17 +62,20 @@ using namespace std;
 /*
  *
  */
-const Type *Type::simple_types[MAX_SIMPLE_TYPES];
+thread_local const Type *Type::simple_types[MAX_SIMPLE_TYPES];
 
-Type *Type::void_type = nullptr;
+thread_local Type *Type::void_type = nullptr;
 
 // ---------------------------------------------------------------------
 // List of all types used in the program
-static vector<Type *> AllTypes;
-static vector<Type *> derived_types;
+static thread_local vector<Type *> AllTypes;
+static thread_local vector<Type *> derived_types;
 
-AttributeGenerator struct_type_attr_generator;
-AttributeGenerator union_type_attr_generator;
+thread_local AttributeGenerator struct_type_attr_generator;
+thread_local AttributeGenerator union_type_attr_generator;
+
+// sequence id of the next struct/union type
+static thread_local unsigned int struct_sequence = 0;
 
 //////////////////////////////////////////////////////////////////////
 
@@ -294,12 +298,11 @@ Type::Type(vector<const Type *> &struct_fields, bool isStruct, bool packed,
       has_assign_ops_(hasAssignOps),
       has_implicit_nontrivial_assign_ops_(hasImplicitNontrivialAssignOps),
       qfers_(qfers), bitfields_length_(fields_length) {
-  static unsigned int sequence = 0;
   if (isStruct)
     eType = eTypeDesc::eStruct;
   else
     eType = eTypeDesc::eUnion;
-  sid = sequence++;
+  sid = struct_sequence++;
 }
 
 // --------------------------------------------------------------
@@ -338,17 +341,8 @@ Type::operator=(const Type& t)
 
 // ---------------------------------------------------------------------
 const Type &Type::get_simple_type(eSimpleType st) {
-  static bool inited = false;
-
   assert(to_index(st) < MAX_SIMPLE_TYPES);
 
-  if (!inited) {
-    for (unsigned int i = 0; i < MAX_SIMPLE_TYPES; ++i) {
-      Type::simple_types[i] = 0;
-    }
-    inited = true;
-  }
-
   if (Type::simple_types[to_index(st)] == 0) {
     // find if type is in the allTypes already (most likely only "eSimpleType::eVoid" is not
     // there)
@@ -1152,6 +1146,7 @@ void Type::GenerateSimpleTypes(void) {
 
 // ---------------------------------------------------------------------
 void GenerateAllTypes(void) {
+  ProfileScope scope(eProfPhase::eTypes);
   InitializeTypeAttributes();
   // In the exhaustive mode, we want to generate all type first.
   // We don't support struct for now
@@ -1942,6 +1937,15 @@ void Type::doFinalization(void) {
   for (auto j = derived_types.begin(); j != derived_types.end(); ++j)
     delete (*j);
   derived_types.clear();
+
+  delete Type::void_type;
+  Type::void_type = nullptr;
+  for (unsigned int i = 0; i < MAX_SIMPLE_TYPES; ++i) {
+    Type::simple_types[i] = 0;
+  }
+  struct_sequence = 0;
+  struct_type_attr_generator.clear();
+  union_type_attr_generator.clear();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
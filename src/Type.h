@@ -326,13 +326,13 @@ public:
               // need of struct's level type qualifiers.
   vector<int> bitfields_length_; // -1 means it's a regular field
 
-  static Type *void_type;
+  static thread_local Type *void_type;
 
 private:
   Type(const Type &) = delete;
   Type &operator=(const Type &) = delete;
 
-  static const Type *simple_types[MAX_SIMPLE_TYPES];
+  static thread_local const Type *simple_types[MAX_SIMPLE_TYPES];
 
   // Package init.
   friend void GenerateAllTypes(void);
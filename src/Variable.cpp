@@ -70,13 +70,16 @@
 #include "util.h"
 
 using namespace std;
-std::vector<std::vector<const Variable *> *> Variable::ctrl_vars_vectors;
-unsigned long Variable::ctrl_vars_count;
+thread_local std::vector<std::vector<const Variable *> *>
+    Variable::ctrl_vars_vectors;
+thread_local unsigned long Variable::ctrl_vars_count;
+thread_local int Variable::effect_id_count = 0;
 
 const char Variable::sink_var_name[] = "csmith_sink_";
 
-bool Variable::var_attr_generate = false;
-AttributeGenerator Variable::var_attr_generator;
+thread_local bool Variable::var_attr_generate = false;
+thread_local bool Variable::access_once_disabled = false;
+thread_local AttributeGenerator Variable::var_attr_generator;
 
 //////////////////////////////////////////////////////////////////////////////
 
@@ -432,7 +435,7 @@ Variable::Variable(const std::string &name, const Type *type,
     : name(name), type(type), init(0), isAuto(isAuto), isStatic(isStatic),
       isRegister(isRegister), isBitfield_(isBitfield), isAddrTaken(false),
       isAccessOnce(false), field_var_of(isFieldVarOf), isArray(false),
-      qfer(isConsts, isVolatiles) {
+      qfer(isConsts, isVolatiles), effect_id(effect_id_count++) {
   // nothing else to do
 }
 
@@ -443,7 +446,8 @@ Variable::Variable(const std::string &name, const Type *type,
                    const Expression *init, const CVQualifiers *qfer)
     : name(name), type(type), init(init), isAuto(false), isStatic(false),
       isRegister(false), isBitfield_(false), isAddrTaken(false),
-      isAccessOnce(false), field_var_of(0), isArray(false), qfer(*qfer) {
+      isAccessOnce(false), field_var_of(0), isArray(false), qfer(*qfer),
+      effect_id(effect_id_count++) {
   // nothing else to do
 }
 
@@ -453,7 +457,7 @@ Variable::Variable(const std::string &name, const Type *type,
     : name(name), type(type), init(init), isAuto(false), isStatic(false),
       isRegister(false), isBitfield_(false), isAddrTaken(false),
       isAccessOnce(false), field_var_of(isFieldVarOf), isArray(isArray),
-      qfer(*qfer) {
+      qfer(*qfer), effect_id(effect_id_count++) {
   // nothing else to do
 }
 
@@ -691,7 +695,8 @@ void Variable::Output(std::ostream &out) const {
     out << "VOL_RVAL(" << get_actual_name() << ", ";
     type->Output(out);
     out << ")";
-  } else if (CGOptions::access_once() && isAccessOnce && !isAddrTaken) {
+  } else if (CGOptions::access_once() && !access_once_disabled &&
+             isAccessOnce && !isAddrTaken) {
     assert(CGOptions::access_once() && "access_once is disabled!");
     out << "ACCESS_ONCE(" << get_actual_name() << ")";
   } else {
@@ -786,6 +791,10 @@ void Variable::doFinalization(void) {
     delete v;
   }
   ctrl_vars_vectors.clear();
+  ctrl_vars_count = 0;
+  effect_id_count = 0;
+  var_attr_generator.clear();
+  var_attr_generate = false;
 }
 
 // --------------------------------------------------------------
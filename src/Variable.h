@@ -43,6 +43,7 @@
 
 #include "CVQualifiers.h"
 #include "Effect.h"
+#include "NodePool.h"
 #include "StdLibAliases.h"
 #include "StringUtils.h"
 #include "Type.h"
@@ -82,6 +83,11 @@ public:
   static void doFinalization(void);
 
   virtual ~Variable(void);
+
+  static void *operator new(size_t size) { return NodePool::allocate(size); }
+  static void operator delete(void *p, size_t size) {
+    NodePool::deallocate(p, size);
+  }
   virtual bool is_global(void) const;
   virtual bool is_local(void) const;
   virtual bool is_visible_local(const Block *blk) const;
@@ -178,13 +184,20 @@ public:
   const Variable *field_var_of; // expanded from a struct/union
   const bool isArray;
   const CVQualifiers qfer;
+  // dense id of the variable within the current program, the bit index used
+  // by Effect. -1 for the dummy variables shared by all programs
+  int effect_id;
   static std::vector<const Variable *> &get_new_ctrl_vars();
   static std::vector<const Variable *> &get_last_ctrl_vars();
 
   static const char sink_var_name[];
 
-  static bool var_attr_generate;
-  static AttributeGenerator var_attr_generator;
+  // set while outputting definitions of global variables, which must not
+  // be wrapped in ACCESS_ONCE
+  static thread_local bool access_once_disabled;
+
+  static thread_local bool var_attr_generate;
+  static thread_local AttributeGenerator var_attr_generator;
 
 private:
   Variable(const std::string &name, const Type *type, const Expression *init,
@@ -198,8 +211,10 @@ private:
            const Variable *isFieldVarOf);
 
   static std::vector<const Variable *> &new_ctrl_vars(void);
-  static std::vector<std::vector<const Variable *> *> ctrl_vars_vectors;
-  static unsigned long ctrl_vars_count;
+  static thread_local std::vector<std::vector<const Variable *> *>
+      ctrl_vars_vectors;
+  static thread_local unsigned long ctrl_vars_count;
+  static thread_local int effect_id_count;
 
   void create_field_vars(const Type *type);
 };
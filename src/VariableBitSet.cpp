@@ -0,0 +1,95 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2026 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <config.h>
+
+#include "VariableBitSet.h"
+
+#include <algorithm>
+#include <cassert>
+
+using namespace std;
+
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+ * grow the window so it spans words first..last
+ */
+void VariableBitSet::cover(size_t first, size_t last) {
+  if (words_.empty()) {
+    first_ = first;
+    words_.assign(last - first + 1, 0);
+    return;
+  }
+  if (first < first_) {
+    words_.insert(words_.begin(), first_ - first, 0);
+    first_ = first;
+  }
+  if (last >= first_ + words_.size()) {
+    words_.resize(last - first_ + 1, 0);
+  }
+}
+
+void VariableBitSet::set(int id) {
+  assert(id >= 0);
+  size_t w = static_cast<size_t>(id) / 64;
+  cover(w, w);
+  words_[w - first_] |= static_cast<uint64_t>(1) << (id % 64);
+}
+
+void VariableBitSet::unite(const VariableBitSet &s) {
+  if (s.words_.empty()) {
+    return;
+  }
+  cover(s.first_, s.first_ + s.words_.size() - 1);
+  for (size_t i = 0; i < s.words_.size(); i++) {
+    words_[s.first_ + i - first_] |= s.words_[i];
+  }
+}
+
+bool VariableBitSet::intersects(const VariableBitSet &s) const {
+  size_t lo = max(first_, s.first_);
+  size_t hi = min(first_ + words_.size(), s.first_ + s.words_.size());
+  for (size_t w = lo; w < hi; w++) {
+    if (words_[w - first_] & s.words_[w - s.first_]) {
+      return true;
+    }
+  }
+  return false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Local Variables:
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+
+// End of file.
@@ -0,0 +1,86 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2026 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef VARIABLE_BIT_SET_H
+#define VARIABLE_BIT_SET_H
+
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+ * A set of variable ids (see Variable::effect_id). Only the window of words
+ * between the lowest and the highest member is stored, so sets of variables
+ * created close to each other (the usual case) stay small while union and
+ * intersection still work a word at a time.
+ */
+class VariableBitSet {
+public:
+  VariableBitSet(void) : first_(0) {}
+
+  bool test(int id) const {
+    size_t w = static_cast<size_t>(id) / 64;
+    if (w < first_ || w >= first_ + words_.size()) {
+      return false;
+    }
+    return (words_[w - first_] >> (id % 64)) & 1;
+  }
+
+  void set(int id);
+  void unite(const VariableBitSet &s);
+  bool intersects(const VariableBitSet &s) const;
+  bool empty(void) const { return words_.empty(); }
+  void clear(void) {
+    first_ = 0;
+    words_.clear();
+  }
+
+private:
+  void cover(size_t first, size_t last);
+
+  // index of the word held in words_[0]
+  size_t first_;
+  std::vector<uint64_t> words_;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // VARIABLE_BIT_SET_H
+
+// Local Variables:
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+
+// End of file.
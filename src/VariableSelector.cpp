@@ -70,10 +70,10 @@ using namespace std;
 
 // --------------------------------------------------------------
 // static variables
-vector<Variable *> VariableSelector::AllVars;
-vector<Variable *> VariableSelector::GlobalList;
-vector<Variable *> VariableSelector::GlobalNonvolatilesList;
-bool VariableSelector::var_created = false;
+thread_local vector<Variable *> VariableSelector::AllVars;
+thread_local vector<Variable *> VariableSelector::GlobalList;
+thread_local vector<Variable *> VariableSelector::GlobalNonvolatilesList;
+thread_local bool VariableSelector::var_created = false;
 
 class VariableSelectFilter : public Filter {
 public:
@@ -101,8 +101,8 @@ bool VariableSelectFilter::filter(int v) const {
   return false;
 }
 
-ProbabilityTable<unsigned int, eVariableScope> *VariableSelector::scopeTable_ =
-    nullptr;
+thread_local ProbabilityTable<unsigned int, eVariableScope>
+    *VariableSelector::scopeTable_ = nullptr;
 
 void VariableSelector::InitScopeTable() {
   if (scopeTable_ == nullptr) {
@@ -152,21 +152,23 @@ Variable *VariableSelector::new_variable(const std::string &name,
  */
 void VariableSelector::expand_struct_union_vars(vector<Variable *> &vars,
                                                 const Type *type) {
-  size_t len = vars.size();
-  for (size_t i = 0; i < len; i++) {
+  // fields are appended to the end (and expanded in turn), while the
+  // variables that are kept stay in their original order
+  vector<Variable *> kept;
+  kept.reserve(vars.size());
+  for (size_t i = 0; i < vars.size(); i++) {
     Variable *tmpvar = vars[i];
     // don't expand virtual variables
-    if (tmpvar->is_virtual())
-      continue;
     // don't break up a struct if it matches the given type
-    if (tmpvar->is_aggregate() && (tmpvar->type != type)) {
-      vars.erase(vars.begin() + i);
+    if (!tmpvar->is_virtual() && tmpvar->is_aggregate() &&
+        (tmpvar->type != type)) {
       vars.insert(vars.end(), tmpvar->field_vars.begin(),
                   tmpvar->field_vars.end());
-      i--;
-      len = vars.size();
+    } else {
+      kept.push_back(tmpvar);
     }
   }
+  vars.swap(kept);
 }
 
 /*
@@ -174,21 +176,23 @@ void VariableSelector::expand_struct_union_vars(vector<Variable *> &vars,
  */
 void VariableSelector::expand_struct_union_vars(vector<const Variable *> &vars,
                                                 const Type *type) {
-  size_t len = vars.size();
-  for (size_t i = 0; i < len; i++) {
+  // fields are appended to the end (and expanded in turn), while the
+  // variables that are kept stay in their original order
+  vector<const Variable *> kept;
+  kept.reserve(vars.size());
+  for (size_t i = 0; i < vars.size(); i++) {
     const Variable *tmpvar = vars[i];
     // don't expand virtual variables
-    if (tmpvar->is_virtual())
-      continue;
     // don't break up a struct if it matches the given type
-    if (tmpvar->is_aggregate() && (tmpvar->type != type)) {
-      vars.erase(vars.begin() + i);
+    if (!tmpvar->is_virtual() && tmpvar->is_aggregate() &&
+        (tmpvar->type != type)) {
       vars.insert(vars.end(), tmpvar->field_vars.begin(),
                   tmpvar->field_vars.end());
-      i--;
-      len = vars.size();
+    } else {
+      kept.push_back(tmpvar);
     }
   }
+  vars.swap(kept);
 }
 
 /* return true if a variable in the list is a pointer to type "type" */
@@ -206,6 +210,27 @@ bool VariableSelector::has_dereferenceable_var(const vector<Variable *> &vars,
   return false;
 }
 
+/*
+ * return true if all the array indices read to access v (see
+ * CGContext::read_indices) are constants, which can be read without any effect
+ */
+static bool has_constant_indices(const Variable *v) {
+  while (v) {
+    if (v->isArray) {
+      const ArrayVariable *av = static_cast<const ArrayVariable *>(v);
+      for (size_t i = 0; i < av->get_indices().size(); i++) {
+        if (av->get_indices()[i]->term_type != eTermType::eConstant) {
+          return false;
+        }
+      }
+    } else if (!v->is_array_field()) {
+      break;
+    }
+    v = v->field_var_of;
+  }
+  return true;
+}
+
 /*
  * check if a variable is eligible to be selected based on current context and
  * read/write + volatile + const rules
@@ -214,11 +239,13 @@ bool VariableSelector::is_eligible_var(const Variable *var, int deref_level,
                                        Effect::Access access,
                                        const CGContext &cg_context) {
   const Variable *coll = var->get_collective();
-  FactMgr *fm = get_fact_mgr(&cg_context);
   if (coll != var) {
-    CGContext cg_tmp(cg_context);
-    if (!cg_tmp.read_indices(var, fm->global_facts)) {
-      return false;
+    if (!has_constant_indices(var)) {
+      FactMgr *fm = get_fact_mgr(&cg_context);
+      CGContext cg_tmp(cg_context);
+      if (!cg_tmp.read_indices(var, fm->global_facts)) {
+        return false;
+      }
     }
     var = coll;
   }
@@ -274,7 +301,8 @@ bool VariableSelector::is_eligible_var(const Variable *var, int deref_level,
   // says that we should not.
   if ((access == Effect::Access::READ) &&
       (cg_context.is_nonreadable(var) ||
-       (FactUnion::is_nonreadable_field(var, fm->global_facts)))) {
+       (FactUnion::is_nonreadable_field(
+           var, get_fact_mgr(&cg_context)->global_facts)))) {
     return false;
   }
   // ISSUE: generating "interesting" C programs.
@@ -293,6 +321,8 @@ bool VariableSelector::has_eligible_volatile_var(const vector<Variable *> &vars,
                                                  const CVQualifiers *qfer,
                                                  Effect::Access access,
                                                  const CGContext &cg_context) {
+  const bool no_volatile =
+      !cg_context.get_effect_context().is_side_effect_free();
   for (size_t i = 0; i < vars.size(); i++) {
     Variable *var = vars[i];
     if (type && !type->match(var->type, eMatchType::eFlexible)) {
@@ -301,6 +331,14 @@ bool VariableSelector::has_eligible_volatile_var(const vector<Variable *> &vars,
     if (qfer && !qfer->match_indirect(var->qfer)) {
       continue;
     }
+    // only volatiles count here, and none of them is eligible in a context
+    // with side effects. Skip the eligibility check in those cases, unless
+    // reading the array indices of var has an effect on the context
+    if (has_constant_indices(var) &&
+        (!var->is_volatile() ||
+         (no_volatile && var->get_collective()->is_volatile()))) {
+      continue;
+    }
     int deref_level =
         var->type->get_indirect_level() - type->get_indirect_level();
     if (is_eligible_var(var, deref_level, access, cg_context) &&
@@ -496,6 +534,7 @@ Variable *VariableSelector::create_and_initialize(
   Variable *var = nullptr;
 
   if (rnd_flipcoin(NewArrayVariableProb())) {
+    ERROR_GUARD(nullptr);
     if (CGOptions::strict_const_arrays()) {
       init = Constant::make_random(t);
     } else {
@@ -506,11 +545,12 @@ Variable *VariableSelector::create_and_initialize(
     init = make_init_value(access, cg_context, t, qfer, blk);
     var = new_variable(name, t, init, qfer);
   }
+  ERROR_GUARD(nullptr);
   assert(var);
   return var;
 }
 
-static int tmp_count = 0;
+static thread_local int tmp_count = 0;
 // --------------------------------------------------------------
 /* Parameter "type"
  * 0 --- To generate any type
@@ -531,6 +571,7 @@ Variable *VariableSelector::GenerateNewGlobal(Effect::Access access,
   tmp_count++;
   Variable *var =
       create_and_initialize(access, cg_context, t, &var_qfer, 0, name);
+  ERROR_GUARD(nullptr);
 
   GlobalList.push_back(var);
   // for DFA
@@ -915,6 +956,7 @@ Variable *VariableSelector::GenerateNewParentLocal(Block &block,
 
   Variable *var =
       create_and_initialize(access, cg_context, t, &var_qfer, blk, name);
+  ERROR_GUARD(nullptr);
   blk->local_vars.push_back(var);
   FactMgr *fm = get_fact_mgr(&cg_context);
   fm->add_new_var_fact_and_update_inout_maps(blk, var->get_collective());
@@ -1312,6 +1354,7 @@ ArrayVariable *VariableSelector::create_array_and_itemize(
  */
 ArrayVariable *
 VariableSelector::create_random_array(const CGContext &cg_context) {
+  ERROR_GUARD(nullptr);
   const bool as_global = CGOptions::global_variables() && rnd_flipcoin(25);
   ERROR_GUARD(nullptr);
   string name;
@@ -1337,8 +1380,10 @@ VariableSelector::create_random_array(const CGContext &cg_context) {
   qfer.add_qualifiers(false, false);
 
   Expression *init = Constant::make_random(type);
+  ERROR_GUARD(nullptr);
   ArrayVariable *av = ArrayVariable::CreateArrayVariable(
       cg_context, blk, name, type, init, &qfer, nullptr);
+  ERROR_GUARD(nullptr);
   AllVars.push_back(av);
 
   // make the points-to fact known to DFA
@@ -1521,7 +1566,10 @@ ArrayVariable *VariableSelector::create_mutated_array_var(
 
 Variable *VariableSelector::make_dummy_static_variable(const string &name) {
   CVQualifiers dummy;
-  Variable *var = new Variable(name, 0, 0, &dummy);
+  // shared by all programs (and threads), so keep it out of the NodePool
+  // and out of Effect bit sets. It is never deleted
+  Variable *var = ::new Variable(name, 0, 0, &dummy);
+  var->effect_id = -1;
   return var;
 }
 
@@ -1545,26 +1593,26 @@ void VariableSelector::doFinalization(void) {
   AllVars.clear();
   GlobalList.clear();
   GlobalNonvolatilesList.clear();
+  var_created = false;
+  tmp_count = 0;
 }
 
 // --------------------------------------------------------------
 void OutputGlobalVariables(std::ostream &out) {
   output_comment_line(out, "--- GLOBAL VARIABLES ---");
   vector<Variable *> &vars = *(VariableSelector::GetGlobalVariables());
-  bool access_once = CGOptions::access_once();
 
-  CGOptions::access_once(false);
+  Variable::access_once_disabled = true;
   OutputVariableList(vars, out);
-  CGOptions::access_once(access_once);
+  Variable::access_once_disabled = false;
 }
 
 void OutputGlobalVariablesDecls(std::ostream &out, const std::string &prefix) {
   output_comment_line(out, "--- GLOBAL VARIABLES ---");
 
-  bool access_once = CGOptions::access_once();
-  CGOptions::access_once(false);
+  Variable::access_once_disabled = true;
   OutputVariableDeclList(*VariableSelector::GetGlobalVariables(), out, prefix);
-  CGOptions::access_once(access_once);
+  Variable::access_once_disabled = false;
 }
 
 void HashGlobalVariables(std::ostream &out) {
@@ -127,7 +127,8 @@ public:
   static void expand_struct_union_vars(vector<const Variable *> &vars,
                                        const Type *type);
 
-  static ProbabilityTable<unsigned int, eVariableScope> *scopeTable_;
+  static thread_local ProbabilityTable<unsigned int, eVariableScope>
+      *scopeTable_;
   static void InitScopeTable();
 
   static vector<Variable *> find_all_visible_vars(const Block *b);
@@ -222,16 +223,16 @@ private:
                                          const std::string &name);
 
   // all variables generated
-  static vector<Variable *> AllVars;
+  static thread_local vector<Variable *> AllVars;
 
   // All globals, including volatiles.
-  static vector<Variable *> GlobalList;
+  static thread_local vector<Variable *> GlobalList;
 
   // All the non-volatile globals.
-  static vector<Variable *> GlobalNonvolatilesList;
+  static thread_local vector<Variable *> GlobalNonvolatilesList;
 
   // flag that indicates whether a new variable has been created
-  static bool var_created;
+  static thread_local bool var_created;
 };
 
 void OutputGlobalVariables(std::ostream &);
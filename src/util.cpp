@@ -46,32 +46,26 @@
 using namespace std;
 ///////////////////////////////////////////////////////////////////////////////
 
-static int gensym_count = 0;
+static thread_local int gensym_count = 0;
 
 void reset_gensym() { gensym_count = 0; }
 
 /*
- *
+ * Every generated program asks for a name many times, so the name is built
+ * without a stream.
  */
 string gensym(const char *basename) {
-  ostringstream ss; //(basename, ios_base::ate); somehow this yields weird
-                    //result on windows
-  ss << basename;
-  ss << ++gensym_count;
-  return ss.str();
+  return basename + std::to_string(++gensym_count);
 }
 
 /*
  *
  */
 string gensym(const string &basename) {
-  ostringstream ss; //(basename, ios_base::ate);
-  ss << basename;
-  ss << ++gensym_count;
-  return ss.str();
+  return basename + std::to_string(++gensym_count);
 }
 
-static std::string errlog;
+static thread_local std::string errlog;
 
 bool log_analysis_fail(const std::string &msg) {
   errlog += "Analysis failed at " + msg + "\n";